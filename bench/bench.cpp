@@ -0,0 +1,42 @@
+#include "bench.hpp"
+#include <iomanip>
+
+namespace geo::bench
+{
+runner::runner(const settings &stt) : m_settings(stt)
+{
+}
+
+const settings &runner::options() const
+{
+    return m_settings;
+}
+const std::vector<result> &runner::results() const
+{
+    return m_results;
+}
+
+void runner::write_csv(std::ostream &stream) const
+{
+    stream << "suite,name,shape,vertices,depth,iterations,ns_per_op,ns_per_op_min\n";
+    for (const result &res : m_results)
+        stream << res.suite << ',' << res.name << ',' << res.shape << ',' << res.vertices << ',' << res.depth << ','
+               << res.iterations << ',' << std::fixed << std::setprecision(3) << res.ns_per_op << ','
+               << res.ns_per_op_min << std::defaultfloat << '\n';
+}
+
+void runner::write_json(std::ostream &stream) const
+{
+    stream << "{\n  \"results\": [";
+    for (std::size_t i = 0; i < m_results.size(); i++)
+    {
+        const result &res = m_results[i];
+        stream << (i == 0 ? "\n" : ",\n") << "    {\"suite\": \"" << res.suite << "\", \"name\": \"" << res.name
+               << "\", \"shape\": \"" << res.shape << "\", \"vertices\": " << res.vertices
+               << ", \"depth\": " << res.depth << ", \"iterations\": " << res.iterations << ", \"ns_per_op\": "
+               << std::fixed << std::setprecision(3) << res.ns_per_op << ", \"ns_per_op_min\": " << res.ns_per_op_min
+               << std::defaultfloat << "}";
+    }
+    stream << "\n  ]\n}\n";
+}
+} // namespace geo::bench
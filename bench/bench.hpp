@@ -0,0 +1,94 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <limits>
+#include <algorithm>
+
+namespace geo::bench
+{
+struct settings
+{
+    std::chrono::nanoseconds min_time = std::chrono::milliseconds(50);
+    std::uint32_t repetitions = 5;
+    std::uint32_t seed = 42;
+};
+
+struct result
+{
+    std::string suite;
+    std::string name;
+    std::string shape;
+    std::size_t vertices;
+    float depth;
+    std::size_t iterations;
+    double ns_per_op;
+    double ns_per_op_min;
+};
+
+class runner
+{
+  public:
+    runner(const settings &stt);
+
+    template <class F>
+    void run(const char *suite, const char *name, const std::string &shape, const std::size_t vertices,
+             const float depth, F &&fun)
+    {
+        std::size_t batch = 1;
+        for (;;)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            for (std::size_t i = 0; i < batch; i++)
+                fun();
+            if (std::chrono::steady_clock::now() - start >= m_settings.min_time / 10 || batch >= (1ULL << 30))
+                break;
+            batch *= 2;
+        }
+
+        double total = 0.0;
+        double best = std::numeric_limits<double>::max();
+        for (std::uint32_t rep = 0; rep < m_settings.repetitions; rep++)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            for (std::size_t i = 0; i < batch; i++)
+                fun();
+            const double elapsed =
+                (double)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start)
+                    .count();
+            const double per_op = elapsed / (double)batch;
+            total += per_op;
+            best = std::min(best, per_op);
+        }
+        m_results.push_back({suite, name, shape, vertices, depth, batch * m_settings.repetitions,
+                             total / m_settings.repetitions, best});
+    }
+
+    const settings &options() const;
+    const std::vector<result> &results() const;
+
+    void write_csv(std::ostream &stream) const;
+    void write_json(std::ostream &stream) const;
+
+  private:
+    settings m_settings;
+    std::vector<result> m_results;
+};
+
+// Prevents the optimizer from discarding benchmarked results
+template <class T> void keep(const T &value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static volatile const void *sink;
+    sink = &value;
+#endif
+}
+
+void run_micro(runner &rnr);
+void run_scenes(runner &rnr);
+} // namespace geo::bench
@@ -0,0 +1,72 @@
+#include "geo/internal/pch.hpp"
+#include "bench.hpp"
+
+#include <cstring>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+static void print_usage(const char *exe)
+{
+    std::cerr << "Usage: " << exe
+              << " [--format csv|json] [--output file] [--suite all|micro|scene] [--min-time ms] [--repetitions n] "
+                 "[--seed n]\n";
+}
+
+int main(int argc, char **argv)
+{
+    geo::bench::settings stt;
+    const char *format = "csv";
+    const char *output = nullptr;
+    const char *suite = "all";
+    for (int i = 1; i < argc; i++)
+    {
+        const bool has_value = i + 1 < argc;
+        if (!std::strcmp(argv[i], "--format") && has_value)
+            format = argv[++i];
+        else if (!std::strcmp(argv[i], "--output") && has_value)
+            output = argv[++i];
+        else if (!std::strcmp(argv[i], "--suite") && has_value)
+            suite = argv[++i];
+        else if (!std::strcmp(argv[i], "--min-time") && has_value)
+            stt.min_time = std::chrono::milliseconds(std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--repetitions") && has_value)
+            stt.repetitions = (std::uint32_t)std::max(1, std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--seed") && has_value)
+            stt.seed = (std::uint32_t)std::atoi(argv[++i]);
+        else
+        {
+            print_usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    const bool json = !std::strcmp(format, "json");
+    if (!json && std::strcmp(format, "csv"))
+    {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    geo::bench::runner rnr{stt};
+    if (!std::strcmp(suite, "all") || !std::strcmp(suite, "micro"))
+        geo::bench::run_micro(rnr);
+    if (!std::strcmp(suite, "all") || !std::strcmp(suite, "scene"))
+        geo::bench::run_scenes(rnr);
+
+    std::ofstream file;
+    if (output)
+    {
+        file.open(output);
+        if (!file)
+        {
+            std::cerr << "Could not open output file: " << output << '\n';
+            return EXIT_FAILURE;
+        }
+    }
+    std::ostream &stream = output ? file : std::cout;
+    if (json)
+        rnr.write_json(stream);
+    else
+        rnr.write_csv(stream);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,412 @@
+#include "geo/internal/pch.hpp"
+#include "bench.hpp"
+#include "geo/algorithm/intersection.hpp"
+#include "geo/algorithm/gjk_batch.hpp"
+#include "geo/algorithm/convex_overlap.hpp"
+#include "geo/algorithm/sdf_grid.hpp"
+#include "geo/algorithm/static_bvh.hpp"
+#include "geo/algorithm/nearest.hpp"
+#include "geo/shapes2D/rounded_polygon.hpp"
+
+#include <random>
+#include <string>
+
+namespace geo::bench
+{
+static constexpr std::array<float, 3> s_depths{-0.25f, 0.05f, 0.5f};
+
+template <std::size_t N> static std::string polygon_name()
+{
+    return "polygon<" + std::to_string(N) + ">";
+}
+
+// Both shapes have unit radius, so a depth of d places their centroids 2 * (1 - d) apart
+static glm::vec2 offset_for_depth(const float depth)
+{
+    return glm::vec2(2.f * (1.f - depth), 0.1f);
+}
+
+template <std::size_t N> static void run_polygon_micro(runner &rnr)
+{
+    const std::string name = polygon_name<N>();
+    const auto verts = polygon<N>::template ngon<N>(1.f, N);
+
+    rnr.run("micro", "polygon_construction", name, N, 0.f, [&verts]() {
+        const polygon<N> poly{verts};
+        keep(poly);
+    });
+
+    const auto desc = make_polygon_descriptor(verts);
+    rnr.run("micro", "polygon_descriptor_construction", name, N, 0.f, [&desc]() {
+        const polygon<N> poly{desc};
+        keep(poly);
+    });
+
+    polygon<N> poly{verts};
+    rnr.run("micro", "update", name, N, 0.f, [&poly]() {
+        poly.update();
+        keep(poly);
+    });
+    rnr.run("micro", "bound", name, N, 0.f, [&poly]() {
+        poly.bound();
+        keep(poly.bounding_box());
+    });
+
+    std::mt19937 rng(rnr.options().seed);
+    std::uniform_real_distribution<float> dist(-1.5f, 1.5f);
+    std::array<glm::vec2, 64> points;
+    for (glm::vec2 &p : points)
+        p = {dist(rng), dist(rng)};
+
+    rnr.run("micro", "contains_point", name, N, 0.f, [&poly, &points]() {
+        std::size_t count = 0;
+        for (const glm::vec2 &p : points)
+            count += poly.contains_point(p);
+        keep(count);
+    });
+    rnr.run("micro", "closest_direction_from", name, N, 0.f, [&poly, &points]() {
+        glm::vec2 sum{0.f};
+        for (const glm::vec2 &p : points)
+            sum += poly.closest_direction_from(p);
+        keep(sum);
+    });
+    rnr.run("micro", "closest_feature_linear", name, N, 0.f, [&poly, &points]() {
+        glm::vec2 sum{0.f};
+        for (const glm::vec2 &p : points)
+            sum += closest_feature_linear(poly.vertices, p).direction;
+        keep(sum);
+    });
+    std::array<closest_feature, 64> features;
+    rnr.run("micro", "closest_features_batch", name, N, 0.f, [&poly, &points, &features]() {
+        closest_features_from(poly.vertices, points, features);
+        keep(features[0]);
+    });
+
+    // Contact point selection queries points inside the polygon, which take the interior scan
+    std::uniform_real_distribution<float> idist(-0.65f, 0.65f);
+    std::array<glm::vec2, 64> interior;
+    for (glm::vec2 &p : interior)
+        p = {idist(rng), idist(rng)};
+    rnr.run("micro", "closest_direction_from_interior", name, N, 0.f, [&poly, &interior]() {
+        glm::vec2 sum{0.f};
+        for (const glm::vec2 &p : interior)
+            sum += poly.closest_direction_from(p);
+        keep(sum);
+    });
+    rnr.run("micro", "closest_feature_linear_interior", name, N, 0.f, [&poly, &interior]() {
+        glm::vec2 sum{0.f};
+        for (const glm::vec2 &p : interior)
+            sum += closest_feature_linear(poly.vertices, p).direction;
+        keep(sum);
+    });
+
+    const circle circ{1.f};
+    for (const float depth : s_depths)
+    {
+        polygon<N> other{verts};
+        other.ltranslate(offset_for_depth(depth));
+
+        rnr.run("micro", "gjk", name, N, depth, [&poly, &other]() {
+            const gjk_result res = gjk(poly, other);
+            keep(res);
+        });
+
+        circle ocirc = circ;
+        ocirc.ltranslate(offset_for_depth(depth));
+        rnr.run("micro", "gjk", name + "/circle", N, depth, [&poly, &ocirc]() {
+            const gjk_result res = gjk(poly, ocirc);
+            keep(res);
+        });
+
+        // The batch repeats the same pair, so both runs solve 64 identical queries
+        const std::vector<gjk_batch_pair> pairs(64, make_gjk_batch_pair(poly, other));
+        std::vector<gjk_result> results(pairs.size());
+        rnr.run("micro", "gjk_x64", name, N, depth, [&poly, &other, &results]() {
+            for (gjk_result &res : results)
+                res = gjk(poly, other);
+            keep(results.back());
+        });
+        rnr.run("micro", "gjk_batch_x64", name, N, depth, [&pairs, &results]() {
+            gjk(pairs, results);
+            keep(results.back());
+        });
+
+        rnr.run("micro", "sat", name, N, depth, [&poly, &other]() {
+            const sat_result res = sat(poly, other);
+            keep(res);
+        });
+        sat_cache cache;
+        rnr.run("micro", "sat_cached", name, N, depth, [&poly, &other, &cache]() {
+            const sat_result res = sat(poly, other, &cache);
+            keep(res);
+        });
+
+        const gjk_result gres = gjk(poly, other);
+        if (!gres.intersect)
+            continue;
+
+        rnr.run("micro", "epa", name, N, depth, [&poly, &other, &gres]() {
+            const mtv_result res = epa(poly, other, gres.simplex);
+            keep(res);
+        });
+        rnr.run("micro", "epa_witness", name, N, depth, [&poly, &other, &gres]() {
+            const epa_result res = epa(poly, other, gres);
+            keep(res);
+        });
+
+        const mtv_result mres = epa(poly, other, gres.simplex);
+        if (!mres.valid)
+            continue;
+
+        rnr.run("micro", "clipping_contacts", name, N, depth, [&poly, &other, &mres]() {
+            const clip_info<2> res = clipping_contacts<2>(poly, other, mres.mtv);
+            keep(res);
+        });
+        const sat_result sres = sat(poly, other);
+        rnr.run("micro", "clipping_contacts_sat", name, N, depth, [&poly, &other, &sres]() {
+            const clip_info<2> res = clipping_contacts<2>(poly, other, sres);
+            keep(res);
+        });
+        rnr.run("micro", "mtv_support_contact_point", name, N, depth, [&poly, &other, &mres]() {
+            const glm::vec2 res = mtv_support_contact_point(poly, other, mres.mtv);
+            keep(res);
+        });
+        rnr.run("micro", "convex_overlap", name, N, depth, [&poly, &other]() {
+            const overlap_info<2 * N> res = convex_overlap<2 * N>(poly, other);
+            keep(res.area);
+        });
+        rnr.run("micro", "convex_overlap_area", name, N, depth, [&poly, &other]() {
+            const float res = convex_overlap_area<2 * N>(poly, other);
+            keep(res);
+        });
+    }
+}
+
+static void run_dynamic_polygon_micro(runner &rnr, const std::uint32_t vertices)
+{
+    const std::vector<glm::vec2> verts = dynamic_polygon::ngon(1.f, vertices);
+    rnr.run("micro", "polygon_construction", "dynamic_polygon", vertices, 0.f, [&verts]() {
+        const dynamic_polygon poly{verts};
+        keep(poly);
+    });
+
+    dynamic_polygon poly{verts};
+    rnr.run("micro", "update", "dynamic_polygon", vertices, 0.f, [&poly]() {
+        poly.update();
+        keep(poly);
+    });
+    for (const float depth : s_depths)
+    {
+        dynamic_polygon other{verts};
+        other.ltranslate(offset_for_depth(depth));
+        rnr.run("micro", "gjk", "dynamic_polygon", vertices, depth, [&poly, &other]() {
+            const gjk_result res = gjk(poly, other);
+            keep(res);
+        });
+    }
+}
+
+static void run_circle_micro(runner &rnr)
+{
+    circle circ{1.f};
+    rnr.run("micro", "update", "circle", 0, 0.f, [&circ]() {
+        circ.update();
+        keep(circ);
+    });
+    rnr.run("micro", "bound", "circle", 0, 0.f, [&circ]() {
+        circ.bound();
+        keep(circ.bounding_box());
+    });
+    for (const float depth : s_depths)
+    {
+        circle other{1.f};
+        other.ltranslate(offset_for_depth(depth));
+        rnr.run("micro", "intersects", "circle", 0, depth, [&circ, &other]() {
+            const bool res = intersects(circ, other);
+            keep(res);
+        });
+        rnr.run("micro", "mtv", "circle", 0, depth, [&circ, &other]() {
+            const mtv_result res = mtv(circ, other);
+            keep(res);
+        });
+    }
+}
+
+// Rounded shapes with unit extent along x, to be compared with the polygon approximations of the same outline
+static void run_rounded_micro(runner &rnr)
+{
+    const capsule cap{1.f, 0.5f};
+    const rounded_polygon<4> rpoly{polygon<4>::square(1.f), 0.5f};
+    for (const float depth : s_depths)
+    {
+        capsule other{1.f, 0.5f};
+        other.ltranslate(offset_for_depth(depth));
+        rnr.run("micro", "mtv", "capsule", 2, depth, [&cap, &other]() {
+            const epa_result res = mtv(cap, other);
+            keep(res);
+        });
+        rnr.run("micro", "rounded_mtv", "capsule", 2, depth, [&cap, &other]() {
+            const epa_result res = rounded_mtv(cap, other);
+            keep(res);
+        });
+
+        rounded_polygon<4> rother = rpoly;
+        rother.ltranslate(offset_for_depth(depth));
+        rnr.run("micro", "rounded_mtv", "rounded_polygon<4>", 4, depth, [&rpoly, &rother]() {
+            const epa_result res = rounded_mtv(rpoly, rother);
+            keep(res);
+        });
+        rnr.run("micro", "gjk_epa", "rounded_polygon<4>", 4, depth, [&rpoly, &rother]() {
+            const gjk_result gres = gjk(rpoly, rother);
+            if (gres.intersect)
+                keep(epa(rpoly, rother, gres));
+        });
+    }
+}
+
+// 1024 small particles against a row of static octagons, through the baked field and through the per-shape path it
+// replaces
+static void run_sdf_micro(runner &rnr)
+{
+    std::vector<polygon<8>> statics;
+    for (std::uint32_t i = 0; i < 16; i++)
+        statics.emplace_back(kit::transform2D<float>{.position = {3.f * (float)i, 0.f}}, polygon<8>::ngon(1.f, 8));
+    std::vector<const shape2D *> shapes;
+    for (const polygon<8> &poly : statics)
+        shapes.push_back(&poly);
+
+    std::mt19937 rng{7};
+    std::uniform_real_distribution<float> xdist{-1.f, 46.f}, ydist{-1.5f, 1.5f};
+    std::vector<glm::vec2> particles(1024);
+    for (glm::vec2 &p : particles)
+        p = {xdist(rng), ydist(rng)};
+    std::vector<sdf_contact> contacts(particles.size());
+
+    const float radius = 0.05f;
+    const sdf_grid grid{shapes};
+    rnr.run("micro", "sdf_contacts_x1024", "polygon<8>", 8, 0.f, [&grid, &particles, &contacts, radius]() {
+        grid.contacts(particles, radius, contacts);
+        keep(contacts[0]);
+    });
+    rnr.run("micro", "shape_contacts_x1024", "polygon<8>", 8, 0.f, [&shapes, &particles, &contacts, radius]() {
+        for (std::size_t i = 0; i < particles.size(); i++)
+        {
+            const circle particle{kit::transform2D<float>{.position = particles[i]}, radius};
+            contacts[i] = {-FLT_MAX, glm::vec2(0.f)};
+            for (const shape2D *shape : shapes)
+                if (may_intersect(*shape, particle))
+                {
+                    const glm::vec2 dir = shape->closest_direction_from(particles[i]);
+                    const float dist = shape->contains_point(particles[i]) ? -glm::length(dir) : glm::length(dir);
+                    if (radius - dist > contacts[i].depth)
+                        contacts[i] = {radius - dist, -glm::normalize(dir)};
+                }
+        }
+        keep(contacts[0]);
+    });
+}
+
+// 16384 random boxes in a 1000 x 1000 region
+static void run_static_bvh_micro(runner &rnr)
+{
+    std::mt19937 rng{11};
+    std::uniform_real_distribution<float> pos{0.f, 1000.f}, size{0.1f, 3.f};
+    std::vector<aabb2D> boxes;
+    for (std::uint32_t i = 0; i < 16384; i++)
+    {
+        const glm::vec2 min{pos(rng), pos(rng)};
+        boxes.emplace_back(min, min + glm::vec2(size(rng), size(rng)));
+    }
+    rnr.run("micro", "static_bvh_build", "aabb2D", boxes.size(), 0.f, [&boxes]() {
+        const static_bvh bvh{boxes};
+        keep(bvh.nodes().size());
+    });
+
+    const static_bvh bvh{boxes};
+    std::vector<aabb2D> queries;
+    std::vector<ray2D> rays;
+    for (std::uint32_t i = 0; i < 64; i++)
+    {
+        const glm::vec2 min{pos(rng), pos(rng)};
+        queries.emplace_back(min, min + glm::vec2(20.f, 10.f));
+        const float angle = pos(rng);
+        rays.push_back({min, {std::cos(angle), std::sin(angle)}, 300.f});
+    }
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> pairs;
+    rnr.run("micro", "static_bvh_overlaps_x64", "aabb2D", boxes.size(), 0.f, [&bvh, &queries, &pairs]() {
+        pairs.clear();
+        bvh.overlaps(queries, pairs);
+        keep(pairs.size());
+    });
+    std::vector<bvh_ray_hit> hits(rays.size());
+    rnr.run("micro", "static_bvh_raycast_x64", "aabb2D", boxes.size(), 0.f, [&bvh, &rays, &hits]() {
+        bvh.raycast(rays, hits);
+        keep(hits[0]);
+    });
+}
+
+static void run_nearest_micro(runner &rnr)
+{
+    std::mt19937 rng{13};
+    std::uniform_real_distribution<float> pos{0.f, 1000.f};
+    std::vector<circle> circles;
+    circles.reserve(4096);
+    std::vector<aabb2D> boxes;
+    for (std::uint32_t i = 0; i < 4096; i++)
+    {
+        kit::transform2D<float> transform;
+        transform.position = {pos(rng), pos(rng)};
+        boxes.push_back(circles.emplace_back(transform, 1.f).bounding_box());
+    }
+    std::vector<const shape2D *> shapes;
+    for (const circle &circ : circles)
+        shapes.push_back(&circ);
+    const static_bvh bvh{boxes};
+
+    std::vector<glm::vec2> points;
+    for (std::uint32_t i = 0; i < 64; i++)
+        points.emplace_back(pos(rng), pos(rng));
+    constexpr std::size_t k = 8;
+    std::vector<bvh_neighbor> neighbors(points.size() * k);
+    rnr.run("micro", "nearest_shapes_k8_x64", "circle", shapes.size(), 0.f, [&]() {
+        nearest_shapes(bvh, shapes, points, k, neighbors);
+        keep(neighbors[0]);
+    });
+    rnr.run("micro", "linear_nearest_k8_x64", "circle", shapes.size(), 0.f, [&]() {
+        std::array<bvh_neighbor, k> best;
+        for (const glm::vec2 &point : points)
+        {
+            best.fill({});
+            for (std::uint32_t i = 0; i < shapes.size(); i++)
+            {
+                const float distance = shape_distance(*shapes[i], point);
+                if (distance < best[k - 1].distance)
+                {
+                    best[k - 1] = {i, distance};
+                    std::sort(best.begin(), best.end(), [](const bvh_neighbor &n1, const bvh_neighbor &n2) {
+                        return n1.distance < n2.distance;
+                    });
+                }
+            }
+            keep(best[0]);
+        }
+    });
+}
+
+void run_micro(runner &rnr)
+{
+    run_circle_micro(rnr);
+    run_rounded_micro(rnr);
+    run_sdf_micro(rnr);
+    run_static_bvh_micro(rnr);
+    run_nearest_micro(rnr);
+    run_polygon_micro<4>(rnr);
+    run_polygon_micro<8>(rnr);
+    run_polygon_micro<16>(rnr);
+    run_polygon_micro<32>(rnr);
+    run_polygon_micro<64>(rnr);
+    run_polygon_micro<128>(rnr);
+    for (const std::uint32_t vertices : {4, 8, 16, 32, 64, 128})
+        run_dynamic_polygon_micro(rnr, vertices);
+}
+} // namespace geo::bench
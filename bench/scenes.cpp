@@ -0,0 +1,142 @@
+#include "geo/internal/pch.hpp"
+#include "bench.hpp"
+#include "geo/algorithm/intersection.hpp"
+
+#include <random>
+#include <string>
+#include <deque>
+
+namespace geo::bench
+{
+template <std::size_t Capacity> struct scene
+{
+    std::deque<circle> circles;
+    std::deque<polygon<Capacity>> polygons;
+    std::vector<shape2D *> shapes;
+    std::vector<bool> is_circle;
+
+    void add(const circle &circ)
+    {
+        shapes.push_back(&circles.emplace_back(circ));
+        is_circle.push_back(true);
+    }
+    void add(const polygon<Capacity> &poly)
+    {
+        shapes.push_back(&polygons.emplace_back(poly));
+        is_circle.push_back(false);
+    }
+
+    // One tick: move every shape, then run a brute force broad-phase followed by the narrow-phase
+    std::size_t step(const float dt)
+    {
+        for (shape2D *sh : shapes)
+            sh->ltranslate(glm::vec2(0.f, -dt));
+
+        std::size_t contacts = 0;
+        for (std::size_t i = 0; i < shapes.size(); i++)
+            for (std::size_t j = i + 1; j < shapes.size(); j++)
+            {
+                const shape2D &sh1 = *shapes[i];
+                const shape2D &sh2 = *shapes[j];
+                if (!may_intersect(sh1, sh2))
+                    continue;
+                if (is_circle[i] && is_circle[j])
+                {
+                    const mtv_result mres =
+                        mtv(static_cast<const circle &>(sh1), static_cast<const circle &>(sh2));
+                    contacts += mres.valid;
+                    continue;
+                }
+                const gjk_result gres = gjk(sh1, sh2);
+                if (!gres.intersect)
+                    continue;
+                const epa_result mres = epa(sh1, sh2, gres);
+                if (!mres.valid)
+                    continue;
+                if (!is_circle[i] && !is_circle[j])
+                    contacts += clipping_contacts<2>(static_cast<const polygon<Capacity> &>(sh1),
+                                                     static_cast<const polygon<Capacity> &>(sh2), mres.mtv)
+                                    .size;
+                else
+                {
+                    keep(mres.witness1);
+                    contacts++;
+                }
+            }
+        for (shape2D *sh : shapes)
+            sh->ltranslate(glm::vec2(0.f, dt));
+        return contacts;
+    }
+};
+
+static void run_random_bodies(runner &rnr, const std::size_t count)
+{
+    std::mt19937 rng(rnr.options().seed);
+    const float extent = 2.f * std::sqrt((float)count);
+    std::uniform_real_distribution<float> pos(-extent, extent);
+    std::uniform_real_distribution<float> size(0.5f, 2.f);
+    std::uniform_int_distribution<std::uint32_t> sides(3, 8);
+
+    scene<8> scn;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        const kit::transform2D<float> transform{.position = {pos(rng), pos(rng)}};
+        if (i % 3 == 0)
+            scn.add(circle{transform, 0.5f * size(rng)});
+        else
+            scn.add(polygon<8>{transform, polygon<8>::ngon(0.5f * size(rng), sides(rng))});
+    }
+    rnr.run("scene", "random_bodies", "bodies=" + std::to_string(count), 8, 0.f, [&scn]() {
+        const std::size_t contacts = scn.step(0.01f);
+        keep(contacts);
+    });
+}
+
+static void run_stacking(runner &rnr, const std::size_t columns, const std::size_t height)
+{
+    scene<4> scn;
+    for (std::size_t i = 0; i < columns; i++)
+        for (std::size_t j = 0; j < height; j++)
+        {
+            const kit::transform2D<float> transform{.position = {3.f * (float)i, 0.98f * (float)j}};
+            scn.add(polygon<4>{transform, polygon<4>::square(1.f)});
+        }
+    rnr.run("scene", "stacking", "bodies=" + std::to_string(columns * height), 4, 0.02f, [&scn]() {
+        const std::size_t contacts = scn.step(0.f);
+        keep(contacts);
+    });
+}
+
+static void run_particle_cloud(runner &rnr, const std::size_t particles)
+{
+    std::mt19937 rng(rnr.options().seed);
+    const float extent = 0.5f * std::sqrt((float)particles);
+    std::uniform_real_distribution<float> pos(-extent, extent);
+
+    scene<32> scn;
+    for (std::size_t i = 0; i < 8; i++)
+    {
+        const kit::transform2D<float> transform{.position = {pos(rng), pos(rng)}};
+        scn.add(polygon<32>{transform, polygon<32>::ngon(0.2f * extent, 32)});
+    }
+    for (std::size_t i = 0; i < particles; i++)
+    {
+        const kit::transform2D<float> transform{.position = {pos(rng), pos(rng)}};
+        scn.add(circle{transform, 0.05f});
+    }
+    rnr.run("scene", "particle_cloud", "bodies=" + std::to_string(particles + 8), 32, 0.f, [&scn]() {
+        const std::size_t contacts = scn.step(0.001f);
+        keep(contacts);
+    });
+}
+
+void run_scenes(runner &rnr)
+{
+    for (const std::size_t count : {64, 256, 1024})
+        run_random_bodies(rnr, count);
+    run_stacking(rnr, 8, 16);
+    run_stacking(rnr, 16, 32);
+    run_particle_cloud(rnr, 1024);
+    run_particle_cloud(rnr, 4096);
+}
+} // namespace geo::bench
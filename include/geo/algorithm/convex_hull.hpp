@@ -0,0 +1,41 @@
+#pragma once
+
+#include "geo/shapes2D/polygon.hpp"
+#include <glm/vec2.hpp>
+#include <vector>
+#include <span>
+#include <optional>
+
+namespace geo
+{
+// Monotone chain hull in counter-clockwise order without collinear or duplicate points. Fewer than 3 points are
+// returned when the input is degenerate
+std::vector<glm::vec2> convex_hull(std::span<const glm::vec2> points);
+
+// Removes the vertices whose removal loses the least area until the hull fits in max_vertices. Vertices whose
+// removal loses less than max_area_loss are removed as well. The result stays convex and inside the original hull
+void reduce_convex_hull(std::vector<glm::vec2> &hull, std::size_t max_vertices, float max_area_loss = 0.f);
+
+template <std::size_t Capacity>
+std::optional<polygon<Capacity>> convex_hull_polygon(const std::span<const glm::vec2> points)
+{
+    KIT_PERF_FUNCTION()
+    std::vector<glm::vec2> hull = convex_hull(points);
+    if (hull.size() < 3)
+        return std::nullopt;
+    reduce_convex_hull(hull, Capacity);
+    return polygon<Capacity>(hull.begin(), hull.end());
+}
+
+template <std::size_t Capacity>
+std::optional<polygon<Capacity>> convex_hull_polygon(const kit::transform2D<float> &ltransform,
+                                                     const std::span<const glm::vec2> points)
+{
+    KIT_PERF_FUNCTION()
+    std::vector<glm::vec2> hull = convex_hull(points);
+    if (hull.size() < 3)
+        return std::nullopt;
+    reduce_convex_hull(hull, Capacity);
+    return polygon<Capacity>(ltransform, hull.begin(), hull.end());
+}
+} // namespace geo
@@ -0,0 +1,192 @@
+#pragma once
+
+#include "geo/algorithm/intersection.hpp"
+#include "kit/utility/utils.hpp"
+#include <glm/vec2.hpp>
+#include <array>
+#include <span>
+#include <utility>
+
+namespace geo
+{
+template <std::size_t MaxVertices> struct overlap_info
+{
+    // Counter-clockwise, in global coordinates
+    std::array<glm::vec2, MaxVertices> vertices;
+    std::size_t size = 0;
+    float area = 0.f;
+    glm::vec2 centroid{0.f};
+};
+
+// Left side of the line through point with the given unit direction. Edges of counter-clockwise polygons keep the
+// polygon on their left
+struct half_plane
+{
+    glm::vec2 point;
+    glm::vec2 direction;
+    float angle;
+
+    bool outside(const glm::vec2 &p) const
+    {
+        return kit::cross2D(direction, p - point) < -1.e-6f;
+    }
+    glm::vec2 intersection(const half_plane &other) const
+    {
+        const float t = kit::cross2D(other.point - point, other.direction) / kit::cross2D(direction, other.direction);
+        return point + t * direction;
+    }
+};
+
+// Edges of a convex polygon are already sorted by angle, up to a rotation that starts them at the smallest angle. The
+// edges of both polygons are merged by angle and intersected as half-planes with a deque, so the whole computation is
+// O(n + m). Calls emit with every vertex of the overlap in counter-clockwise order, and returns their amount, which is
+// zero if the polygons do not overlap or only touch. MaxVertices must be at least the sum of both vertex counts
+template <std::size_t MaxVertices, Polygon Polygon1, Polygon Polygon2, class F>
+std::size_t convex_overlap_vertices(const Polygon1 &poly1, const Polygon2 &poly2, F &&emit)
+{
+    KIT_ASSERT_ERROR(poly1.convex() && poly2.convex(), "Both polygons must be convex to compute their overlap")
+    const std::size_t size1 = poly1.vertices.size(), size2 = poly2.vertices.size();
+    KIT_ASSERT_ERROR(size1 + size2 <= MaxVertices,
+                     "MaxVertices must hold the vertices of both polygons: {0} + {1} > {2}", size1, size2,
+                     MaxVertices)
+
+    const auto edge = [](const auto &poly, const std::size_t i) {
+        const glm::vec2 &start = poly.vertices.globals[i];
+        const glm::vec2 direction = glm::normalize(poly.vertices.globals[i + 1] - start);
+        return half_plane{start, direction, pseudo_angle(direction)};
+    };
+    const auto first_edge = [&edge](const auto &poly) {
+        std::size_t first = 0;
+        float min_angle = edge(poly, 0).angle;
+        for (std::size_t i = 1; i < poly.vertices.size(); i++)
+        {
+            const float angle = edge(poly, i).angle;
+            if (angle < min_angle)
+            {
+                min_angle = angle;
+                first = i;
+            }
+        }
+        return first;
+    };
+
+    // Only pushes at the back and pops at both ends, so a flat array with two cursors is enough
+    std::array<half_plane, MaxVertices> planes;
+    std::size_t front = 0, back = 0;
+    const auto add = [&planes, &front, &back](const half_plane &hp) {
+        while (back - front > 1 && hp.outside(planes[back - 1].intersection(planes[back - 2])))
+            back--;
+        while (back - front > 1 && hp.outside(planes[front].intersection(planes[front + 1])))
+            front++;
+        if (back > front)
+        {
+            const half_plane &last = planes[back - 1];
+            if (kit::approaches_zero(kit::cross2D(hp.direction, last.direction)))
+            {
+                // Opposite parallel planes meeting here leave no room between them
+                if (glm::dot(hp.direction, last.direction) < 0.f)
+                    return false;
+                if (!hp.outside(last.point))
+                    return true;
+                back--;
+            }
+        }
+        planes[back++] = hp;
+        return true;
+    };
+
+    const std::size_t start1 = first_edge(poly1), start2 = first_edge(poly2);
+    std::size_t i1 = 0, i2 = 0;
+    half_plane next1 = edge(poly1, start1), next2 = edge(poly2, start2);
+    while (i1 < size1 || i2 < size2)
+    {
+        if (i2 == size2 || (i1 < size1 && next1.angle <= next2.angle))
+        {
+            if (!add(next1))
+                return 0;
+            if (++i1 < size1)
+                next1 = edge(poly1, start1 + i1);
+        }
+        else
+        {
+            if (!add(next2))
+                return 0;
+            if (++i2 < size2)
+                next2 = edge(poly2, start2 + i2);
+        }
+    }
+
+    while (back - front > 2 && planes[front].outside(planes[back - 1].intersection(planes[back - 2])))
+        back--;
+    while (back - front > 2 && planes[back - 1].outside(planes[front].intersection(planes[front + 1])))
+        front++;
+    if (back - front < 3)
+        return 0;
+
+    for (std::size_t i = front; i < back; i++)
+        emit(planes[i].intersection(planes[i + 1 < back ? i + 1 : front]));
+    return back - front;
+}
+
+// Area and centroid are accumulated over a fan from the first vertex, which is exact for the convex overlap
+template <std::size_t MaxVertices, Polygon Polygon1, Polygon Polygon2>
+overlap_info<MaxVertices> convex_overlap(const Polygon1 &poly1, const Polygon2 &poly2)
+{
+    KIT_PERF_FUNCTION()
+    overlap_info<MaxVertices> result;
+    if (!intersects(poly1.bounding_box(), poly2.bounding_box()))
+        return result;
+
+    convex_overlap_vertices<MaxVertices>(poly1, poly2,
+                                         [&result](const glm::vec2 &v) { result.vertices[result.size++] = v; });
+    if (result.size < 3)
+    {
+        result.size = 0;
+        return result;
+    }
+
+    const glm::vec2 &origin = result.vertices[0];
+    glm::vec2 moment(0.f);
+    for (std::size_t i = 1; i + 1 < result.size; i++)
+    {
+        const glm::vec2 e1 = result.vertices[i] - origin, e2 = result.vertices[i + 1] - origin;
+        const float crs = kit::cross2D(e1, e2);
+        result.area += 0.5f * crs;
+        moment += crs * (e1 + e2) / 6.f;
+    }
+    result.centroid = result.area > 0.f ? origin + moment / result.area : origin;
+    return result;
+}
+
+// Skips storing the overlap and the centroid. Vertices are consumed as they are emitted
+template <std::size_t MaxVertices, Polygon Polygon1, Polygon Polygon2>
+float convex_overlap_area(const Polygon1 &poly1, const Polygon2 &poly2)
+{
+    if (!intersects(poly1.bounding_box(), poly2.bounding_box()))
+        return 0.f;
+
+    glm::vec2 origin, previous;
+    float area = 0.f;
+    std::size_t count = 0;
+    convex_overlap_vertices<MaxVertices>(poly1, poly2, [&](const glm::vec2 &v) {
+        if (count == 0)
+            origin = v;
+        else if (count > 1)
+            area += kit::cross2D(previous - origin, v - origin);
+        previous = v;
+        count++;
+    });
+    return 0.5f * area;
+}
+
+template <std::size_t MaxVertices, Polygon Polygon1, Polygon Polygon2>
+void convex_overlap_areas(const std::span<const std::pair<const Polygon1 *, const Polygon2 *>> pairs,
+                          const std::span<float> areas)
+{
+    KIT_PERF_FUNCTION()
+    KIT_ASSERT_ERROR(areas.size() >= pairs.size(), "Not enough room for areas: {0} pairs and {1} slots", pairs.size(),
+                     areas.size())
+    for (std::size_t i = 0; i < pairs.size(); i++)
+        areas[i] = convex_overlap_area<MaxVertices>(*pairs[i].first, *pairs[i].second);
+}
+} // namespace geo
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <glm/vec2.hpp>
+#include <vector>
+#include <span>
+
+namespace geo
+{
+// Splits a simple polygon (given in any winding order, without holes) into convex pieces with the Hertel-Mehlhorn
+// algorithm: the outline is ear-clipped into triangles and the diagonals that are not essential for convexity are
+// removed, as long as the merged pieces have at most max_vertices vertices. Every piece is counter-clockwise
+std::vector<std::vector<glm::vec2>> convex_decomposition(std::span<const glm::vec2> outline,
+                                                         std::size_t max_vertices);
+} // namespace geo
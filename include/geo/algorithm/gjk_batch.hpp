@@ -0,0 +1,67 @@
+#pragma once
+
+#include "geo/algorithm/intersection.hpp"
+#include <glm/vec2.hpp>
+#include <span>
+#include <ranges>
+
+namespace geo
+{
+inline constexpr std::size_t GJK_LANES = 8;
+
+// One polygon of a batched pair. Its global vertices are read through vertices.globals[i] when the group of the pair is
+// solved, so any Polygon works, including those decoding their vertices on the fly such as static_polygon
+struct gjk_batch_polygon
+{
+    const void *poly;
+    std::size_t size;
+    // Writes vertex i to x[i * GJK_LANES] and y[i * GJK_LANES]
+    void (*load)(const void *poly, float *x, float *y);
+};
+
+template <Polygon T> gjk_batch_polygon make_gjk_batch_polygon(const T &poly)
+{
+    return {&poly, poly.vertices.size(), [](const void *ptr, float *x, float *y) {
+                const T &p = *static_cast<const T *>(ptr);
+                const std::size_t size = p.vertices.size();
+                // Contiguous vertices are read directly, skipping the index wrapping of the subscript operator
+                if constexpr (std::ranges::contiguous_range<decltype(p.vertices.globals)>)
+                {
+                    const glm::vec2 *globals = std::ranges::data(p.vertices.globals);
+                    for (std::size_t i = 0; i < size; i++)
+                    {
+                        x[i * GJK_LANES] = globals[i].x;
+                        y[i * GJK_LANES] = globals[i].y;
+                    }
+                }
+                else
+                    for (std::size_t i = 0; i < size; i++)
+                    {
+                        const glm::vec2 v = p.vertices.globals[i];
+                        x[i * GJK_LANES] = v.x;
+                        y[i * GJK_LANES] = v.y;
+                    }
+            }};
+}
+
+// Polygons and centroids of a pair. The vertices are copied when the group of the pair is solved, so the polygons must
+// outlive the batch and must not be updated until it is solved
+struct gjk_batch_pair
+{
+    gjk_batch_polygon poly1;
+    gjk_batch_polygon poly2;
+    glm::vec2 centroid1;
+    glm::vec2 centroid2;
+};
+
+template <Polygon Polygon1, Polygon Polygon2>
+gjk_batch_pair make_gjk_batch_pair(const Polygon1 &poly1, const Polygon2 &poly2)
+{
+    return {make_gjk_batch_polygon(poly1), make_gjk_batch_polygon(poly2), poly1.gcentroid(), poly2.gcentroid()};
+}
+
+// Runs gjk on GJK_LANES pairs at once, keeping the state of every pair in lane arrays so that each step is a
+// fixed-width loop the compiler can vectorize. Lanes that terminate early are masked out until the whole group is
+// done. Results match the scalar gjk, including the support points needed by epa
+void gjk(std::span<const gjk_batch_pair> pairs, std::span<gjk_result> results);
+} // namespace geo
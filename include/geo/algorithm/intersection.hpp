@@ -1,11 +1,20 @@
 #pragma once
 
 #include "geo/shapes2D/circle.hpp"
+#include "geo/shapes2D/capsule.hpp"
 #include "geo/shapes2D/polygon.hpp"
+#include "geo/shapes2D/dynamic_polygon.hpp"
 #include "geo/shapes2D/aabb2D.hpp"
+#include "geo/profiling/stats.hpp"
+#include "geo/profiling/recorder.hpp"
+#include "geo/profiling/timeline.hpp"
 #include <glm/vec2.hpp>
 #include <array>
+#include <limits>
+#include <algorithm>
 #include <utility>
+#include <concepts>
+#include <type_traits>
 
 namespace geo
 {
@@ -13,17 +22,46 @@ struct gjk_result
 {
     bool intersect;
     std::array<glm::vec2, 3> simplex;
+
+    // Support points of each shape behind every simplex vertex: simplex[i] = supports1[i] - supports2[i]
+    std::array<glm::vec2, 3> supports1;
+    std::array<glm::vec2, 3> supports2;
 };
 struct mtv_result
 {
     bool valid;
     glm::vec2 mtv;
 };
+// witness1 lies on sh1 and witness2 on sh2, with witness1 - witness2 = mtv
+struct epa_result : mtv_result
+{
+    glm::vec2 witness1;
+    glm::vec2 witness2;
+};
 
 gjk_result gjk(const shape2D &sh1, const shape2D &sh2);
 mtv_result epa(const shape2D &sh1, const shape2D &sh2, const std::array<glm::vec2, 3> &simplex,
                float threshold = 1.e-3f);
 
+// Also returns the witness points of the penetration, which makes mtv_support_contact_point unnecessary
+epa_result epa(const shape2D &sh1, const shape2D &sh2, const gjk_result &gjk_res, float threshold = 1.e-3f);
+
+struct distance_result
+{
+    // When the cores overlap, the distance and witness points are meaningless
+    bool overlap;
+    float distance;
+    glm::vec2 witness1;
+    glm::vec2 witness2;
+};
+
+// Closest points between the cores of two shapes (see shape2D::core_support_point)
+distance_result gjk_distance(const shape2D &sh1, const shape2D &sh2, std::uint32_t max_iterations = 32);
+
+// Works for any pair of shapes, but gjk and epa only run on the cores and the radii are added analytically, so rounded
+// shapes converge as fast as their cores
+epa_result rounded_mtv(const shape2D &sh1, const shape2D &sh2, float threshold = 1.e-3f);
+
 glm::vec2 mtv_support_contact_point(const shape2D &sh1, const shape2D &sh2, const glm::vec2 &mtv);
 bool may_intersect(const shape2D &sh1, const shape2D &sh2);
 
@@ -34,49 +72,38 @@ bool intersects(const circle &c1, const circle &c2);
 mtv_result mtv(const circle &c1, const circle &c2);
 glm::vec2 radius_distance_contact_point(const circle &c1, const circle &c2);
 
+bool intersects(const capsule &cap, const circle &circ);
+bool intersects(const capsule &cap1, const capsule &cap2);
+epa_result mtv(const capsule &cap, const circle &circ);
+epa_result mtv(const capsule &cap1, const capsule &cap2);
+
 template <std::size_t MaxPoints> struct clip_info
 {
     std::array<glm::vec2, MaxPoints> contacts;
     std::uint8_t size = 0;
 };
 
-template <std::size_t MaxPoints, std::size_t Capacity>
-clip_info<MaxPoints> clipping_contacts(const polygon<Capacity> &poly1, const polygon<Capacity> &poly2,
-                                       const glm::vec2 &mtv, bool include_intersections = true)
-{
-    float max_dot = glm::dot(mtv, poly1.vertices.normals[0]);
-    std::size_t normal_index = 0;
-
-    const polygon<Capacity> *ref_poly = &poly1;
-    const polygon<Capacity> *inc_poly = &poly2;
+// Any polygon exposing vertices.globals and vertices.normals with wrapping indices, such as polygon<Capacity> or
+// dynamic_polygon
+template <class T>
+concept Polygon = std::is_base_of_v<shape2D, T> && requires(const T &poly, std::size_t index) {
+    { poly.vertices.size() } -> std::convertible_to<std::size_t>;
+    { poly.vertices.globals[index] } -> std::convertible_to<glm::vec2>;
+    { poly.vertices.normals[index] } -> std::convertible_to<glm::vec2>;
+};
 
-    for (std::size_t i = 1; i < poly1.vertices.size(); i++)
-    {
-        const float dot = glm::dot(mtv, poly1.vertices.normals[i]);
-        if (dot > max_dot)
-        {
-            max_dot = dot;
-            normal_index = i;
-        }
-    }
-    for (std::size_t i = 0; i < poly2.vertices.size(); i++)
-    {
-        const float dot = glm::dot(-mtv, poly2.vertices.normals[i]);
-        if (dot > max_dot)
-        {
-            max_dot = dot;
-            normal_index = i;
-            ref_poly = &poly2;
-            inc_poly = &poly1;
-        }
-    }
-    const glm::vec2 &normal = ref_poly->vertices.normals[normal_index];
-    const glm::vec2 &start = ref_poly->vertices.globals[normal_index];
-    const auto &inc_globals = inc_poly->vertices.globals;
+// Clips the incident polygon against the reference face starting at ref.vertices.globals[normal_index]
+template <std::size_t MaxPoints, Polygon Reference, Polygon Incident>
+clip_info<MaxPoints> clip_incident_polygon(const Reference &ref_poly, const Incident &inc_poly,
+                                           const std::size_t normal_index, const bool include_intersections)
+{
+    const glm::vec2 &normal = ref_poly.vertices.normals[normal_index];
+    const glm::vec2 &start = ref_poly.vertices.globals[normal_index];
+    const auto &inc_globals = inc_poly.vertices.globals;
 
     clip_info<MaxPoints> result;
     float current_dot = glm::dot(inc_globals[0] - start, normal);
-    for (std::size_t i = 0; i < inc_poly->vertices.size(); i++)
+    for (std::size_t i = 0; i < inc_poly.vertices.size(); i++)
     {
         const float next_dot = glm::dot(inc_globals[i + 1] - start, normal);
         if (current_dot <= 0.f)
@@ -87,8 +114,8 @@ clip_info<MaxPoints> clipping_contacts(const polygon<Capacity> &poly1, const pol
         }
         if (include_intersections && current_dot * next_dot < 0.f)
         {
-            const float current_abs = abs(current_dot);
-            const float next_abs = abs(next_dot);
+            const float current_abs = std::abs(current_dot);
+            const float next_abs = std::abs(next_dot);
             result.contacts[result.size++] =
                 inc_globals[i] + (inc_globals[i + 1] - inc_globals[i]) * current_abs / (current_abs + next_abs);
             if (result.size == MaxPoints)
@@ -97,9 +124,142 @@ clip_info<MaxPoints> clipping_contacts(const polygon<Capacity> &poly1, const pol
 
         current_dot = next_dot;
     }
-    if (ref_poly != &poly1)
+    return result;
+}
+
+// Separating axis of a polygon pair, meant to be kept per pair (for instance as a pair_manager payload) and fed back
+// to sat on the next query
+struct sat_cache
+{
+    std::size_t normal_index = 0;
+    bool poly1_reference = true;
+    bool valid = false;
+};
+
+// The reference face is the face of maximum separation, starting at vertices.globals[normal_index] of poly1 or poly2.
+// When the polygons intersect, separation is the negated penetration depth and mtv follows the epa convention
+struct sat_result
+{
+    bool intersect;
+    bool poly1_reference;
+    std::size_t normal_index;
+    float separation;
+    glm::vec2 mtv;
+};
+
+// Signed distance from the reference face to the deepest vertex of the incident polygon
+template <Polygon Reference, Polygon Incident>
+float face_separation(const Reference &ref_poly, const Incident &inc_poly, const std::size_t normal_index)
+{
+    const glm::vec2 &normal = ref_poly.vertices.normals[normal_index];
+    const glm::vec2 &start = ref_poly.vertices.globals[normal_index];
+
+    float min_dot = glm::dot(inc_poly.vertices.globals[0] - start, normal);
+    for (std::size_t i = 1; i < inc_poly.vertices.size(); i++)
+        min_dot = std::min(min_dot, glm::dot(inc_poly.vertices.globals[i] - start, normal));
+    return min_dot;
+}
+
+// Tests the cached axis first: separated pairs that remain separated exit after a single projection, and
+// intersecting pairs keep their reference face unless another one is strictly better
+template <Polygon Polygon1, Polygon Polygon2>
+sat_result sat(const Polygon1 &poly1, const Polygon2 &poly2, sat_cache *cache = nullptr)
+{
+    GEO_TIMELINE_FUNCTION(NARROW_PHASE)
+    GEO_RECORD(recorder::record_sat(poly1, poly2, cache);)
+    sat_result result{false, true, 0, -std::numeric_limits<float>::max(), glm::vec2(0.f)};
+    GEO_STATS(std::uint32_t axes = 0; bool cache_exit = false;)
+
+    const bool use_cache = cache && cache->valid &&
+                           cache->normal_index < (cache->poly1_reference ? poly1.vertices.size() : poly2.vertices.size());
+    if (use_cache)
+    {
+        GEO_STATS(axes++;)
+        result.poly1_reference = cache->poly1_reference;
+        result.normal_index = cache->normal_index;
+        result.separation = cache->poly1_reference ? face_separation(poly1, poly2, cache->normal_index)
+                                                   : face_separation(poly2, poly1, cache->normal_index);
+        GEO_STATS(cache_exit = result.separation > 0.f;)
+    }
+
+    const auto search = [&](const auto &ref_poly, const auto &inc_poly, const bool poly1_reference) {
+        for (std::size_t i = 0; i < ref_poly.vertices.size() && result.separation <= 0.f; i++)
+        {
+            if (use_cache && cache->poly1_reference == poly1_reference && cache->normal_index == i)
+                continue;
+            GEO_STATS(axes++;)
+            const float separation = face_separation(ref_poly, inc_poly, i);
+            if (separation > result.separation)
+            {
+                result.separation = separation;
+                result.normal_index = i;
+                result.poly1_reference = poly1_reference;
+            }
+        }
+    };
+    search(poly1, poly2, true);
+    search(poly2, poly1, false);
+
+    result.intersect = result.separation <= 0.f;
+    if (result.intersect)
+        result.mtv = result.poly1_reference ? -result.separation * poly1.vertices.normals[result.normal_index]
+                                            : result.separation * poly2.vertices.normals[result.normal_index];
+    if (cache)
+        *cache = {result.normal_index, result.poly1_reference, true};
+
+    GEO_STATS(stats::record_sat(poly1, poly2, axes, cache_exit, result.intersect);)
+    return result;
+}
+
+// Uses the reference face found by sat instead of searching it again
+template <std::size_t MaxPoints, Polygon Polygon1, Polygon Polygon2>
+clip_info<MaxPoints> clipping_contacts(const Polygon1 &poly1, const Polygon2 &poly2, const sat_result &sat_res,
+                                       bool include_intersections = true)
+{
+    GEO_TIMELINE_FUNCTION(NARROW_PHASE)
+    GEO_RECORD(recorder::record_clipping(poly1, poly2, sat_res, include_intersections, MaxPoints);)
+    clip_info<MaxPoints> result;
+    if (sat_res.poly1_reference)
+        result = clip_incident_polygon<MaxPoints>(poly1, poly2, sat_res.normal_index, include_intersections);
+    else
+    {
+        result = clip_incident_polygon<MaxPoints>(poly2, poly1, sat_res.normal_index, include_intersections);
         for (std::size_t i = 0; i < result.size; i++)
-            result.contacts[i] += mtv;
+            result.contacts[i] += sat_res.mtv;
+    }
+    GEO_STATS(stats::record_clipping(poly1, poly2, result.size);)
     return result;
 }
+
+template <std::size_t MaxPoints, Polygon Polygon1, Polygon Polygon2>
+clip_info<MaxPoints> clipping_contacts(const Polygon1 &poly1, const Polygon2 &poly2, const glm::vec2 &mtv,
+                                       bool include_intersections = true)
+{
+    float max_dot = glm::dot(mtv, poly1.vertices.normals[0]);
+    std::size_t normal_index = 0;
+    bool poly1_reference = true;
+
+    for (std::size_t i = 1; i < poly1.vertices.size(); i++)
+    {
+        const float dot = glm::dot(mtv, poly1.vertices.normals[i]);
+        if (dot > max_dot)
+        {
+            max_dot = dot;
+            normal_index = i;
+        }
+    }
+    for (std::size_t i = 0; i < poly2.vertices.size(); i++)
+    {
+        const float dot = glm::dot(-mtv, poly2.vertices.normals[i]);
+        if (dot > max_dot)
+        {
+            max_dot = dot;
+            normal_index = i;
+            poly1_reference = false;
+        }
+    }
+
+    return clipping_contacts<MaxPoints>(poly1, poly2, sat_result{true, poly1_reference, normal_index, 0.f, mtv},
+                                        include_intersections);
+}
 } // namespace geo
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "geo/algorithm/static_bvh.hpp"
+#include "geo/shapes2D/shape2D.hpp"
+#include <glm/vec2.hpp>
+#include <span>
+#include <cfloat>
+
+namespace geo
+{
+// Zero when the shape contains the point
+float shape_distance(const shape2D &shape, const glm::vec2 &point);
+// Closest distance between the cores with the radii subtracted, zero when the shapes overlap
+float shape_distance(const shape2D &sh1, const shape2D &sh2);
+
+// Nearest shapes through a static_bvh built from their bounding boxes, so that shapes[i] is the shape of box i. The
+// exact distance is only computed for shapes whose box is closer than the current k-th neighbor, where k is the size
+// of neighbors. Neighbors are sorted by increasing distance, and the amount found is returned
+std::size_t nearest_shapes(const static_bvh &bvh, std::span<const shape2D *const> shapes, const glm::vec2 &point,
+                           std::span<bvh_neighbor> neighbors, float max_distance = FLT_MAX);
+
+// The shape itself is skipped if it belongs to shapes
+std::size_t nearest_shapes(const static_bvh &bvh, std::span<const shape2D *const> shapes, const shape2D &shape,
+                           std::span<bvh_neighbor> neighbors, float max_distance = FLT_MAX);
+
+// k neighbors per point, stored contiguously. Slots left without a neighbor have an index of static_bvh::NONE
+void nearest_shapes(const static_bvh &bvh, std::span<const shape2D *const> shapes, std::span<const glm::vec2> points,
+                    std::size_t k, std::span<bvh_neighbor> neighbors, float max_distance = FLT_MAX);
+} // namespace geo
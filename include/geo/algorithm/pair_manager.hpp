@@ -0,0 +1,225 @@
+#pragma once
+
+#include "geo/shapes2D/shape2D.hpp"
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include <bit>
+
+namespace geo
+{
+enum class pair_event
+{
+    BEGIN,
+    PERSIST,
+    END
+};
+
+// Keeps track of the overlapping pairs reported by a broad-phase across ticks, so that they do not have to be
+// rebuilt and diffed every tick. A tick consists of begin_tick(), one report() per overlapping pair and end_tick(),
+// which emits END for, and removes, every pair that was not reported during the tick. Each pair owns a payload (a
+// GJK cache, a contact manifold...) that lives from its BEGIN event until its END event.
+// Pairs are unordered and live in a dense array. They are found through an open addressing table (linear probing
+// with backward shift deletion) that only stores the handles and the dense index, so probing stays compact
+template <class Payload, class Handle = const shape2D *, class Hash = std::hash<Handle>> class pair_manager
+{
+  public:
+    struct pair
+    {
+        Handle first;
+        Handle second;
+        Payload payload;
+    };
+
+    // The reference is invalidated by the next call to report() or end_tick()
+    struct report_result
+    {
+        pair_event event;
+        pair &entry;
+    };
+
+    pair_manager(const std::size_t capacity = 32)
+    {
+        m_pairs.reserve(capacity);
+        m_ticks.reserve(capacity);
+        rehash(std::bit_ceil(std::max<std::size_t>(2 * capacity, 16)));
+    }
+
+    void begin_tick()
+    {
+        m_tick++;
+    }
+
+    // Reporting the same pair more than once during a tick is allowed and yields PERSIST after the first report
+    report_result report(Handle first, Handle second)
+    {
+        order(first, second);
+        const std::size_t mask = m_slots.size() - 1;
+        std::size_t i = key_hash(first, second) & mask;
+        for (; m_slots[i].index != EMPTY; i = (i + 1) & mask)
+        {
+            const slot &sl = m_slots[i];
+            if (sl.first == first && sl.second == second)
+            {
+                m_ticks[sl.index] = m_tick;
+                return {pair_event::PERSIST, m_pairs[sl.index]};
+            }
+        }
+
+        if (2 * (m_pairs.size() + 1) > m_slots.size())
+        {
+            rehash(2 * m_slots.size());
+            return report(first, second);
+        }
+        m_slots[i] = {first, second, (std::uint32_t)m_pairs.size()};
+        m_ticks.push_back(m_tick);
+        return {pair_event::BEGIN, m_pairs.emplace_back(pair{first, second, Payload{}})};
+    }
+
+    // Calls fun(pair &) with every pair that was not reported during the current tick, right before removing it
+    template <class F> void end_tick(F &&fun)
+    {
+        for (std::size_t i = m_pairs.size(); i-- > 0;)
+            if (m_ticks[i] != m_tick)
+            {
+                fun(m_pairs[i]);
+                remove(i);
+            }
+    }
+    void end_tick()
+    {
+        end_tick([](pair &) {});
+    }
+
+    Payload *find(Handle first, Handle second)
+    {
+        order(first, second);
+        const std::size_t slot_index = find_slot(first, second);
+        return slot_index != NOT_FOUND ? &m_pairs[m_slots[slot_index].index].payload : nullptr;
+    }
+
+    // Removes every pair involving handle without emitting END, for example when its shape is destroyed
+    void erase(const Handle &handle)
+    {
+        for (std::size_t i = m_pairs.size(); i-- > 0;)
+            if (m_pairs[i].first == handle || m_pairs[i].second == handle)
+                remove(i);
+    }
+
+    auto begin()
+    {
+        return m_pairs.begin();
+    }
+    auto end()
+    {
+        return m_pairs.end();
+    }
+    auto begin() const
+    {
+        return m_pairs.begin();
+    }
+    auto end() const
+    {
+        return m_pairs.end();
+    }
+
+    std::size_t size() const
+    {
+        return m_pairs.size();
+    }
+    bool empty() const
+    {
+        return m_pairs.empty();
+    }
+    void clear()
+    {
+        m_pairs.clear();
+        m_ticks.clear();
+        std::fill(m_slots.begin(), m_slots.end(), slot{});
+    }
+
+  private:
+    static inline constexpr std::uint32_t EMPTY = UINT32_MAX;
+    static inline constexpr std::size_t NOT_FOUND = SIZE_MAX;
+    struct slot
+    {
+        Handle first{};
+        Handle second{};
+        std::uint32_t index = EMPTY;
+    };
+
+    std::vector<slot> m_slots;
+    std::vector<pair> m_pairs;
+    std::vector<std::uint64_t> m_ticks;
+    std::uint64_t m_tick = 0;
+    [[no_unique_address]] Hash m_hash{};
+
+    static void order(Handle &first, Handle &second)
+    {
+        if (std::less<Handle>{}(second, first))
+            std::swap(first, second);
+    }
+
+    std::size_t key_hash(const Handle &first, const Handle &second) const
+    {
+        std::size_t h = m_hash(first) * 0x9E3779B97F4A7C15ULL;
+        h ^= m_hash(second) + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+        return h ^ (h >> 29);
+    }
+
+    std::size_t find_slot(const Handle &first, const Handle &second) const
+    {
+        const std::size_t mask = m_slots.size() - 1;
+        for (std::size_t i = key_hash(first, second) & mask; m_slots[i].index != EMPTY; i = (i + 1) & mask)
+            if (m_slots[i].first == first && m_slots[i].second == second)
+                return i;
+        return NOT_FOUND;
+    }
+
+    // Removes the dense entry at index by swapping it with the last one
+    void remove(const std::size_t index)
+    {
+        erase_slot(find_slot(m_pairs[index].first, m_pairs[index].second));
+        const std::size_t last = m_pairs.size() - 1;
+        if (index != last)
+        {
+            m_pairs[index] = std::move(m_pairs[last]);
+            m_ticks[index] = m_ticks[last];
+            m_slots[find_slot(m_pairs[index].first, m_pairs[index].second)].index = (std::uint32_t)index;
+        }
+        m_pairs.pop_back();
+        m_ticks.pop_back();
+    }
+
+    void erase_slot(std::size_t hole)
+    {
+        const std::size_t mask = m_slots.size() - 1;
+        m_slots[hole] = slot{};
+        for (std::size_t i = (hole + 1) & mask; m_slots[i].index != EMPTY; i = (i + 1) & mask)
+        {
+            const std::size_t home = key_hash(m_slots[i].first, m_slots[i].second) & mask;
+            // Entries whose home lies cyclically in (hole, i] would become unreachable if moved into the hole
+            const bool stays = hole <= i ? (home > hole && home <= i) : (home > hole || home <= i);
+            if (stays)
+                continue;
+            m_slots[hole] = m_slots[i];
+            m_slots[i] = slot{};
+            hole = i;
+        }
+    }
+
+    void rehash(const std::size_t capacity)
+    {
+        m_slots.assign(capacity, slot{});
+        const std::size_t mask = capacity - 1;
+        for (std::size_t index = 0; index < m_pairs.size(); index++)
+        {
+            const pair &pr = m_pairs[index];
+            std::size_t i = key_hash(pr.first, pr.second) & mask;
+            while (m_slots[i].index != EMPTY)
+                i = (i + 1) & mask;
+            m_slots[i] = {pr.first, pr.second, (std::uint32_t)index};
+        }
+    }
+};
+} // namespace geo
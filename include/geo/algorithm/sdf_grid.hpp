@@ -0,0 +1,101 @@
+#pragma once
+
+#include "geo/shapes2D/shape2D.hpp"
+#include "geo/shapes2D/aabb2D.hpp"
+#include <glm/vec2.hpp>
+#include <vector>
+#include <span>
+#include <string>
+#include <cstdint>
+
+namespace geo
+{
+struct sdf_settings
+{
+    // Distance between two consecutive samples
+    float cell_size = 0.05f;
+
+    // Distances are exact within this band around the geometry and clamped to it beyond. The grid covers the bounding
+    // box of the geometry grown by the band
+    float band = 1.f;
+
+    // Zero uses the hardware concurrency
+    std::uint32_t threads = 0;
+};
+
+struct sdf_sample
+{
+    float distance;
+    glm::vec2 gradient;
+};
+
+// Negative depth means the particle is not touching the geometry. The normal points away from the geometry, and is
+// zero outside the grid or in flat regions of the field
+struct sdf_contact
+{
+    float depth;
+    glm::vec2 normal;
+};
+
+// Signed distance field of a set of static convex shapes, sampled on a regular grid. Distances are negative inside the
+// geometry. Samples are stored in square tiles so that a bilinear lookup and the bake of a tile touch few cache lines.
+// The grid does not track the shapes: it must be baked again if they move
+class sdf_grid
+{
+  public:
+    static inline constexpr std::uint32_t TILE_SIZE = 8;
+
+    sdf_grid() = default;
+    sdf_grid(std::span<const shape2D *const> shapes, const sdf_settings &settings = {});
+
+    // Each thread bakes whole tiles, evaluating only the shapes whose bounding boxes are within the band of the tile
+    void bake(std::span<const shape2D *const> shapes, const sdf_settings &settings = {});
+
+    // Loads the grid from path if it was baked from the same shapes and settings, and bakes and saves it otherwise.
+    // Returns true if the grid was loaded from the cache
+    bool cached_bake(const std::string &path, std::span<const shape2D *const> shapes,
+                     const sdf_settings &settings = {});
+
+    bool save(const std::string &path) const;
+    // Returns false and leaves the grid untouched if the file cannot be read or its fingerprint does not match
+    bool load(const std::string &path, std::uint64_t fingerprint);
+
+    // Hash of the bounding boxes, centroids, areas and inertias of the shapes together with the settings. Used to
+    // invalidate cached bakes
+    static std::uint64_t fingerprint(std::span<const shape2D *const> shapes, const sdf_settings &settings);
+
+    // Bilinear interpolation of the four closest samples. Points outside the grid are at least a band away
+    float distance(const glm::vec2 &p) const;
+    sdf_sample sample(const glm::vec2 &p) const;
+
+    sdf_contact contact(const glm::vec2 &position, float radius) const;
+    void contacts(std::span<const glm::vec2> positions, float radius, std::span<sdf_contact> contacts) const;
+    void contacts(std::span<const glm::vec2> positions, std::span<const float> radii,
+                  std::span<sdf_contact> contacts) const;
+
+    const aabb2D &bounds() const;
+    float cell_size() const;
+    float band() const;
+    std::uint32_t width() const;
+    std::uint32_t height() const;
+    std::uint64_t fingerprint() const;
+    bool empty() const;
+
+  private:
+    aabb2D m_bounds;
+    float m_cell_size = 0.f;
+    float m_inv_cell_size = 0.f;
+    float m_band = 0.f;
+    std::uint32_t m_width = 0;
+    std::uint32_t m_height = 0;
+    std::uint32_t m_tiles_x = 0;
+    std::uint64_t m_fingerprint = 0;
+    std::vector<sdf_sample> m_samples;
+
+    std::size_t index(std::uint32_t x, std::uint32_t y) const;
+    glm::vec2 sample_position(std::uint32_t x, std::uint32_t y) const;
+
+    void bake_tile(std::uint32_t tile, std::span<const shape2D *const> shapes);
+    void compute_gradients(std::uint32_t tile);
+};
+} // namespace geo
@@ -0,0 +1,173 @@
+#pragma once
+
+#include "geo/algorithm/convex_hull.hpp"
+#include "geo/shapes2D/polygon.hpp"
+#include <array>
+#include <tuple>
+#include <vector>
+#include <utility>
+
+namespace geo
+{
+// Removes the vertices whose removal loses the least area until the polygon fits in OutCapacity vertices, as well as
+// every vertex whose removal loses less than max_area_loss. Removing vertices keeps a convex polygon convex and inside
+// the original. The simplified centroid moves, so the local origin is shifted to keep the polygon in place
+template <std::size_t OutCapacity, std::size_t Capacity>
+    requires(OutCapacity >= 3)
+polygon<OutCapacity> simplify(const polygon<Capacity> &poly, const float max_area_loss = 0.f)
+{
+    KIT_PERF_FUNCTION()
+    KIT_ASSERT_WARN(poly.convex(), "Simplifying a non convex polygon may yield a self intersecting one")
+    std::vector<glm::vec2> model{poly.vertices.model.begin(), poly.vertices.model.end()};
+    reduce_convex_hull(model, OutCapacity, max_area_loss);
+
+    const glm::vec2 centroid = polygon_center_of_mass(model);
+    kit::transform2D<float> ltransform = poly.ltransform();
+    ltransform.origin -= centroid;
+    return polygon<OutCapacity>(ltransform, model.begin(), model.end());
+}
+
+// A polygon together with simplified versions of it, one per entry of LodCapacities. Level 0 is the original, and
+// each level is simplified from the previous one so that coarser levels never have more vertices. All levels share the
+// same transform through the setters below, which must be used instead of modifying the levels directly
+template <std::size_t Capacity, std::size_t... LodCapacities> class polygon_lod
+{
+  public:
+    static inline constexpr std::size_t LEVELS = 1 + sizeof...(LodCapacities);
+
+    // max_area_losses[i] is forwarded to simplify when building level i + 1. switch_distances[i] is the distance from
+    // which level i + 1 is selected, and must be increasing
+    polygon_lod(const polygon<Capacity> &poly, const std::array<float, LEVELS - 1> &max_area_losses = {},
+                const std::array<float, LEVELS - 1> &switch_distances = {})
+        : m_switch_distances(switch_distances)
+    {
+        std::get<0>(m_levels) = poly;
+        simplify_levels<1>(max_area_losses);
+        for_each([this, &poly]<std::size_t Level>(const auto &level) {
+            m_origin_offsets[Level] = level.ltransform().origin - poly.ltransform().origin;
+        });
+    }
+
+    template <std::size_t Level> const auto &level() const
+    {
+        return std::get<Level>(m_levels);
+    }
+    const shape2D &level(const std::size_t index) const
+    {
+        return visit(index, [](const shape2D &level) -> const shape2D & { return level; });
+    }
+    std::size_t size(const std::size_t index) const
+    {
+        return visit(index, [](const auto &level) { return level.vertices.size(); });
+    }
+
+    // Calls fun with the concrete polygon type of the level, so that templated algorithms such as sat can be used
+    template <class F> decltype(auto) visit(const std::size_t index, F &&fun) const
+    {
+        KIT_ASSERT_ERROR(index < LEVELS, "Level index out of bounds: {0} for {1} levels", index, LEVELS)
+        return visit_from<0>(index, std::forward<F>(fun));
+    }
+
+    std::size_t select(const float distance) const
+    {
+        std::size_t index = 0;
+        while (index < LEVELS - 1 && distance >= m_switch_distances[index])
+            index++;
+        return index;
+    }
+    const std::array<float, LEVELS - 1> &switch_distances() const
+    {
+        return m_switch_distances;
+    }
+    void switch_distances(const std::array<float, LEVELS - 1> &switch_distances)
+    {
+        m_switch_distances = switch_distances;
+    }
+
+    const kit::transform2D<float> &ltransform() const
+    {
+        return level<0>().ltransform();
+    }
+    void ltransform(const kit::transform2D<float> &ltransform)
+    {
+        for_each([this, &ltransform]<std::size_t Level>(auto &level) {
+            kit::transform2D<float> shifted = ltransform;
+            shifted.origin += m_origin_offsets[Level];
+            level.ltransform(shifted);
+        });
+    }
+    void origin(const glm::vec2 &origin)
+    {
+        for_each([this, &origin]<std::size_t Level>(auto &level) { level.origin(origin + m_origin_offsets[Level]); });
+    }
+    void parent(const kit::transform2D<float> *parent)
+    {
+        for_each([parent]<std::size_t>(auto &level) { level.parent(parent); });
+    }
+
+    void lposition(const glm::vec2 &lposition)
+    {
+        for_each([&lposition]<std::size_t>(auto &level) { level.lposition(lposition); });
+    }
+    void lscale(const glm::vec2 &lscale)
+    {
+        for_each([&lscale]<std::size_t>(auto &level) { level.lscale(lscale); });
+    }
+    void lrotation(const float lrotation)
+    {
+        for_each([lrotation]<std::size_t>(auto &level) { level.lrotation(lrotation); });
+    }
+    void ltranslate(const glm::vec2 &dpos)
+    {
+        for_each([&dpos]<std::size_t>(auto &level) { level.ltranslate(dpos); });
+    }
+    void lrotate(const float drotation)
+    {
+        for_each([drotation]<std::size_t>(auto &level) { level.lrotate(drotation); });
+    }
+
+  private:
+    std::tuple<polygon<Capacity>, polygon<LodCapacities>...> m_levels;
+    std::array<glm::vec2, LEVELS> m_origin_offsets;
+    std::array<float, LEVELS - 1> m_switch_distances;
+
+    template <std::size_t Level> void simplify_levels(const std::array<float, LEVELS - 1> &max_area_losses)
+    {
+        if constexpr (Level < LEVELS)
+        {
+            constexpr std::size_t capacity = std::array{Capacity, LodCapacities...}[Level];
+            std::get<Level>(m_levels) = simplify<capacity>(std::get<Level - 1>(m_levels), max_area_losses[Level - 1]);
+            simplify_levels<Level + 1>(max_area_losses);
+        }
+    }
+
+    template <std::size_t Level, class F> decltype(auto) visit_from(const std::size_t index, F &&fun) const
+    {
+        if constexpr (Level + 1 == LEVELS)
+            return fun(std::get<Level>(m_levels));
+        else
+        {
+            if (index == Level)
+                return fun(std::get<Level>(m_levels));
+            return visit_from<Level + 1>(index, std::forward<F>(fun));
+        }
+    }
+
+    template <class F> void for_each(F &&fun)
+    {
+        for_each_impl(std::forward<F>(fun), std::make_index_sequence<LEVELS>{});
+    }
+    template <class F> void for_each(F &&fun) const
+    {
+        for_each_impl(std::forward<F>(fun), std::make_index_sequence<LEVELS>{});
+    }
+    template <class F, std::size_t... Levels> void for_each_impl(F &&fun, std::index_sequence<Levels...>)
+    {
+        (fun.template operator()<Levels>(std::get<Levels>(m_levels)), ...);
+    }
+    template <class F, std::size_t... Levels> void for_each_impl(F &&fun, std::index_sequence<Levels...>) const
+    {
+        (fun.template operator()<Levels>(std::get<Levels>(m_levels)), ...);
+    }
+};
+} // namespace geo
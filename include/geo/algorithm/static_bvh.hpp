@@ -0,0 +1,309 @@
+#pragma once
+
+#include "geo/shapes2D/aabb2D.hpp"
+#include <glm/vec2.hpp>
+#include <vector>
+#include <array>
+#include <span>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <algorithm>
+#include <cfloat>
+
+namespace geo
+{
+struct static_bvh_settings
+{
+    std::uint32_t max_leaf_size = 4;
+    std::uint32_t bins = 16;
+
+    // Zero uses the hardware concurrency. Ranges smaller than parallel_threshold are always built by a single thread
+    std::uint32_t threads = 0;
+    std::uint32_t parallel_threshold = 4096;
+};
+
+// Distances along a ray are measured in units of its direction, which does not need to be normalized
+struct ray2D
+{
+    glm::vec2 origin;
+    glm::vec2 direction;
+    float max_distance = FLT_MAX;
+};
+
+struct bvh_ray_hit
+{
+    std::uint32_t index = UINT32_MAX;
+    float distance = FLT_MAX;
+};
+
+struct bvh_neighbor
+{
+    std::uint32_t index = UINT32_MAX;
+    float distance = FLT_MAX;
+};
+
+// Slab test. Returns true if the ray enters the box before max_distance, storing the entry distance, which is zero if
+// the origin is inside the box
+inline bool ray_entry(const aabb2D &bb, const glm::vec2 &origin, const glm::vec2 &inv_direction,
+                      const float max_distance, float &entry)
+{
+    const glm::vec2 t1 = (bb.min - origin) * inv_direction;
+    const glm::vec2 t2 = (bb.max - origin) * inv_direction;
+    const float tmin = std::max({0.f, std::min(t1.x, t2.x), std::min(t1.y, t2.y)});
+    const float tmax = std::min({max_distance, std::max(t1.x, t2.x), std::max(t1.y, t2.y)});
+    entry = tmin;
+    return tmin <= tmax;
+}
+
+// Immutable bounding volume hierarchy over a set of bounding boxes, meant for static geometry loaded all at once. It
+// is built top-down with binned SAH, with large ranges split across threads, and then flattened in depth-first order:
+// the left child of a node is always the next node, so only the right child index is stored. Leaves reference a
+// contiguous range of the boxes, which are copied in leaf order. Primitives are reported by their index in the input
+class static_bvh
+{
+  public:
+    static inline constexpr std::uint32_t NONE = UINT32_MAX;
+
+    // Internal nodes have a count of zero and index the right child. Leaves index their first primitive
+    struct node
+    {
+        aabb2D aabb;
+        std::uint32_t index;
+        std::uint32_t count;
+    };
+
+    static_bvh() = default;
+    static_bvh(std::span<const aabb2D> boxes, const static_bvh_settings &settings = {});
+
+    void build(std::span<const aabb2D> boxes, const static_bvh_settings &settings = {});
+
+    // Calls fun with the index of every box overlapping aabb. If fun returns a bool, returning true stops the traversal
+    template <class F> void query(const aabb2D &aabb, F &&fun) const
+    {
+        if (m_nodes.empty())
+            return;
+        std::array<std::uint32_t, STACK_SIZE> stack;
+        std::size_t size = 0;
+        stack[size++] = 0;
+        while (size > 0)
+        {
+            const std::uint32_t index = stack[--size];
+            const node &nd = m_nodes[index];
+            if (!boxes_overlap(nd.aabb, aabb))
+                continue;
+            if (nd.count == 0)
+            {
+                stack[size++] = nd.index;
+                stack[size++] = index + 1;
+                continue;
+            }
+            for (std::uint32_t i = nd.index; i < nd.index + nd.count; i++)
+                if (boxes_overlap(m_boxes[i], aabb))
+                {
+                    if constexpr (std::is_same_v<std::invoke_result_t<F, std::uint32_t>, bool>)
+                    {
+                        if (fun(m_indices[i]))
+                            return;
+                    }
+                    else
+                        fun(m_indices[i]);
+                }
+        }
+    }
+
+    // Visits the boxes hit by the ray roughly front to back, calling fun(index, entry) with the distance at which the
+    // ray enters each box. fun returns the new maximum distance of the ray, so that returning the distance of an exact
+    // hit prunes every box behind it and returning ray.max_distance keeps the ray unchanged
+    template <class F> void raycast(const ray2D &ray, F &&fun) const
+    {
+        if (m_nodes.empty())
+            return;
+        const glm::vec2 inv_direction = 1.f / ray.direction;
+        float max_distance = ray.max_distance;
+
+        std::array<std::pair<std::uint32_t, float>, STACK_SIZE> stack;
+        std::size_t size = 0;
+        float entry;
+        if (!ray_entry(m_nodes[0].aabb, ray.origin, inv_direction, max_distance, entry))
+            return;
+        stack[size++] = {0, entry};
+        while (size > 0)
+        {
+            const auto [index, node_entry] = stack[--size];
+            if (node_entry > max_distance)
+                continue;
+            const node &nd = m_nodes[index];
+            if (nd.count != 0)
+            {
+                for (std::uint32_t i = nd.index; i < nd.index + nd.count; i++)
+                    if (ray_entry(m_boxes[i], ray.origin, inv_direction, max_distance, entry))
+                        max_distance = std::min(max_distance, fun(m_indices[i], entry));
+                continue;
+            }
+
+            float entry1, entry2;
+            const bool hit1 = ray_entry(m_nodes[index + 1].aabb, ray.origin, inv_direction, max_distance, entry1);
+            const bool hit2 = ray_entry(m_nodes[nd.index].aabb, ray.origin, inv_direction, max_distance, entry2);
+            if (hit1 && hit2)
+            {
+                // The nearest child is pushed last so that it is visited first
+                if (entry1 <= entry2)
+                {
+                    stack[size++] = {nd.index, entry2};
+                    stack[size++] = {index + 1, entry1};
+                }
+                else
+                {
+                    stack[size++] = {index + 1, entry1};
+                    stack[size++] = {nd.index, entry2};
+                }
+            }
+            else if (hit1)
+                stack[size++] = {index + 1, entry1};
+            else if (hit2)
+                stack[size++] = {nd.index, entry2};
+        }
+    }
+
+    // Best-first search of the neighbors.size() primitives closest to the query box, sorted by increasing distance.
+    // Nodes are visited in order of the distance between their box and the query, which is a lower bound of the
+    // distance to every primitive below them, so fun(index) only computes the exact distance to primitives whose box
+    // is closer than the current k-th neighbor. Primitives must lie inside their box. Only neighbors closer than
+    // max_distance are reported. Returns the amount of neighbors found
+    template <class F>
+    std::size_t nearest(const aabb2D &aabb, const std::span<bvh_neighbor> neighbors, F &&fun,
+                        const float max_distance = FLT_MAX) const
+    {
+        std::vector<std::pair<float, std::uint32_t>> heap;
+        heap.reserve(STACK_SIZE);
+        return best_first(aabb, neighbors, fun, max_distance, heap);
+    }
+    template <class F>
+    std::size_t nearest(const glm::vec2 &point, const std::span<bvh_neighbor> neighbors, F &&fun,
+                        const float max_distance = FLT_MAX) const
+    {
+        return nearest(aabb2D(point), neighbors, std::forward<F>(fun), max_distance);
+    }
+
+    // k neighbors per point, stored contiguously. Slots left without a neighbor have an index of NONE. fun is called
+    // as fun(point index, box index)
+    template <class F>
+    void nearest(const std::span<const glm::vec2> points, const std::size_t k, const std::span<bvh_neighbor> neighbors,
+                 F &&fun, const float max_distance = FLT_MAX) const
+    {
+        KIT_ASSERT_ERROR(neighbors.size() >= points.size() * k,
+                         "Not enough room for neighbors: {0} points with {1} neighbors each and {2} slots",
+                         points.size(), k, neighbors.size())
+        std::vector<std::pair<float, std::uint32_t>> heap;
+        heap.reserve(STACK_SIZE);
+        for (std::size_t i = 0; i < points.size(); i++)
+        {
+            const std::span<bvh_neighbor> slots = neighbors.subspan(i * k, k);
+            const auto point_fun = [&fun, i](const std::uint32_t index) { return fun(i, index); };
+            const std::size_t found = best_first(aabb2D(points[i]), slots, point_fun, max_distance, heap);
+            std::fill(slots.begin() + found, slots.end(), bvh_neighbor{});
+        }
+    }
+
+    // Appends a (query index, box index) pair for every overlap
+    void overlaps(std::span<const aabb2D> queries, std::vector<std::pair<std::uint32_t, std::uint32_t>> &pairs) const;
+
+    // Closest box hit by each ray, or an index of NONE if the ray misses every box
+    void raycast(std::span<const ray2D> rays, std::span<bvh_ray_hit> hits) const;
+
+    const std::vector<node> &nodes() const;
+    // Boxes and their input indices in leaf order
+    const std::vector<aabb2D> &boxes() const;
+    const std::vector<std::uint32_t> &indices() const;
+
+    std::size_t size() const;
+    bool empty() const;
+
+  private:
+    // Splits deeper than 32 levels halve their range instead of using SAH, which bounds the depth of the tree
+    static inline constexpr std::size_t STACK_SIZE = 96;
+
+    std::vector<node> m_nodes;
+    std::vector<aabb2D> m_boxes;
+    std::vector<std::uint32_t> m_indices;
+
+    static bool boxes_overlap(const aabb2D &bb1, const aabb2D &bb2)
+    {
+        return bb1.min.x <= bb2.max.x && bb1.max.x >= bb2.min.x && bb1.min.y <= bb2.max.y && bb1.max.y >= bb2.min.y;
+    }
+    static float boxes_distance2(const aabb2D &bb1, const aabb2D &bb2)
+    {
+        const glm::vec2 gap = glm::max(glm::max(bb1.min - bb2.max, bb2.min - bb1.max), glm::vec2(0.f));
+        return gap.x * gap.x + gap.y * gap.y;
+    }
+
+    // The node heap is a min-heap on the squared box distance, and the neighbors a max-heap on the exact distance
+    // while they are being collected, so that the k-th neighbor is always at the front
+    template <class F>
+    std::size_t best_first(const aabb2D &aabb, const std::span<bvh_neighbor> neighbors, F &fun,
+                           const float max_distance, std::vector<std::pair<float, std::uint32_t>> &heap) const
+    {
+        const std::size_t k = neighbors.size();
+        if (m_nodes.empty() || k == 0)
+            return 0;
+
+        const auto closer_node = [](const std::pair<float, std::uint32_t> &n1,
+                                    const std::pair<float, std::uint32_t> &n2) { return n1.first > n2.first; };
+        const auto closer_neighbor = [](const bvh_neighbor &n1, const bvh_neighbor &n2) {
+            return n1.distance < n2.distance;
+        };
+
+        std::size_t found = 0;
+        float bound = max_distance;
+        float bound2 = bound * bound;
+        heap.clear();
+        heap.emplace_back(boxes_distance2(m_nodes[0].aabb, aabb), 0);
+        while (!heap.empty())
+        {
+            std::pop_heap(heap.begin(), heap.end(), closer_node);
+            const auto [distance2, index] = heap.back();
+            heap.pop_back();
+            // Every remaining node is at least this far away
+            if (distance2 >= bound2)
+                break;
+
+            const node &nd = m_nodes[index];
+            if (nd.count == 0)
+            {
+                for (const std::uint32_t child : {index + 1, nd.index})
+                {
+                    const float child_distance2 = boxes_distance2(m_nodes[child].aabb, aabb);
+                    if (child_distance2 < bound2)
+                    {
+                        heap.emplace_back(child_distance2, child);
+                        std::push_heap(heap.begin(), heap.end(), closer_node);
+                    }
+                }
+                continue;
+            }
+            for (std::uint32_t i = nd.index; i < nd.index + nd.count; i++)
+            {
+                if (boxes_distance2(m_boxes[i], aabb) >= bound2)
+                    continue;
+                const float distance = fun(m_indices[i]);
+                if (distance >= bound)
+                    continue;
+                if (found == k)
+                    std::pop_heap(neighbors.begin(), neighbors.end(), closer_neighbor);
+                else
+                    found++;
+                neighbors[found - 1] = {m_indices[i], distance};
+                std::push_heap(neighbors.begin(), neighbors.begin() + found, closer_neighbor);
+                if (found == k)
+                {
+                    bound = neighbors[0].distance;
+                    bound2 = bound * bound;
+                }
+            }
+        }
+        std::sort_heap(neighbors.begin(), neighbors.begin() + found, closer_neighbor);
+        return found;
+    }
+};
+} // namespace geo
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace geo
+{
+// Calls fun(i) for every i in [0, count) across threads, which pick the next index from a shared counter so that
+// uneven work balances itself. Zero threads uses the hardware concurrency. The calling thread takes part in the work.
+// If fun throws, the indices not yet picked are skipped, and the first exception is rethrown once every thread stopped
+template <class F> void parallel_for(const std::uint32_t count, std::uint32_t threads, F &&fun)
+{
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min(threads, count);
+
+    std::atomic<std::uint32_t> next{0};
+    std::mutex error_mutex;
+    std::exception_ptr error;
+    const auto worker = [&next, &fun, &error_mutex, &error, count]() {
+        for (std::uint32_t i = next.fetch_add(1, std::memory_order_relaxed); i < count;
+             i = next.fetch_add(1, std::memory_order_relaxed))
+            try
+            {
+                fun(i);
+            }
+            catch (...)
+            {
+                next.store(count, std::memory_order_relaxed);
+                std::scoped_lock lock{error_mutex};
+                if (!error)
+                    error = std::current_exception();
+                return;
+            }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads > 0 ? threads - 1 : 0);
+    for (std::uint32_t i = 1; i < threads; i++)
+        pool.emplace_back(worker);
+    worker();
+    for (std::thread &thread : pool)
+        thread.join();
+    if (error)
+        std::rethrow_exception(error);
+}
+} // namespace geo
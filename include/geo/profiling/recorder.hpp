@@ -0,0 +1,89 @@
+#pragma once
+
+#ifdef GEO_ENABLE_RECORDER
+#include "geo/profiling/trace.hpp"
+#include "geo/shapes2D/circle.hpp"
+#include "geo/shapes2D/capsule.hpp"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+#define GEO_RECORD(...) __VA_ARGS__
+#else
+#define GEO_RECORD(...)
+#endif
+
+#ifdef GEO_ENABLE_RECORDER
+namespace geo
+{
+class shape2D;
+struct sat_cache;
+struct sat_result;
+} // namespace geo
+
+// Records the inputs of narrow phase queries to a binary trace (see trace.hpp) that the replay tool re-executes with
+// timings per query. Only queries between tracked shapes are recorded: tracking a shape assigns it an id and captures
+// its geometry once, so that every query only stores both ids, the poses of the shapes and the query thresholds.
+// Queries are buffered per thread and written in large blocks, so recording costs a hash lookup and a few dozen bytes
+// of copying per query, and a single function call while the recorder is stopped
+namespace geo::recorder
+{
+// Starts a new trace at path, emitting the geometry of every tracked shape. Returns false if the file cannot be opened
+bool start(const std::string &path);
+// Flushes the buffers of every thread and closes the trace
+void stop();
+bool recording();
+
+// Queries skipped since the last start because one of their shapes was not tracked
+std::uint64_t dropped();
+
+// Shapes must be tracked again after their geometry changes, and untracked before they are destroyed. Tracking a
+// shape again assigns it a new id. Returns the id of the shape
+std::uint32_t track(const shape2D &shape, const trace::shape_geometry &geometry);
+void untrack(const shape2D &shape);
+
+// Works for circles, capsules, rounded polygons and any polygon exposing its model vertices, such as polygon<Capacity>
+// or dynamic_polygon
+template <class Shape> std::uint32_t track(const Shape &shape)
+{
+    trace::shape_geometry geometry;
+    if constexpr (std::is_same_v<Shape, circle>)
+    {
+        geometry.type = trace::shape_type::CIRCLE;
+        geometry.radius = shape.radius();
+    }
+    else if constexpr (std::is_same_v<Shape, capsule>)
+    {
+        geometry.type = trace::shape_type::CAPSULE;
+        geometry.radius = shape.radius();
+        geometry.length = shape.length();
+    }
+    else if constexpr (requires { shape.core.model[0]; })
+    {
+        geometry.type = trace::shape_type::POLYGON;
+        geometry.radius = shape.radius();
+        for (std::size_t i = 0; i < shape.core.size(); i++)
+            geometry.vertices.push_back(shape.core.model[i]);
+    }
+    else
+    {
+        static_assert(requires { shape.vertices.model[0]; }, "The recorder cannot capture the geometry of this shape");
+        geometry.type = trace::shape_type::POLYGON;
+        for (std::size_t i = 0; i < shape.vertices.size(); i++)
+            geometry.vertices.push_back(shape.vertices.model[i]);
+    }
+    return track(shape, geometry);
+}
+
+void record_gjk(const shape2D &sh1, const shape2D &sh2);
+void record_epa(const shape2D &sh1, const shape2D &sh2, float threshold);
+void record_epa(const shape2D &sh1, const shape2D &sh2, const std::array<glm::vec2, 3> &simplex, float threshold);
+void record_gjk_distance(const shape2D &sh1, const shape2D &sh2, std::uint32_t max_iterations);
+void record_rounded_mtv(const shape2D &sh1, const shape2D &sh2, float threshold);
+void record_contact_point(const shape2D &sh1, const shape2D &sh2, const glm::vec2 &mtv);
+void record_sat(const shape2D &sh1, const shape2D &sh2, const sat_cache *cache);
+void record_clipping(const shape2D &sh1, const shape2D &sh2, const sat_result &sat_res, bool include_intersections,
+                     std::size_t max_points);
+} // namespace geo::recorder
+#endif
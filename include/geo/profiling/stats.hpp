@@ -0,0 +1,102 @@
+#pragma once
+
+#ifdef GEO_ENABLE_STATS
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#define GEO_STATS(...) __VA_ARGS__
+#else
+#define GEO_STATS(...)
+#endif
+
+#ifdef GEO_ENABLE_STATS
+namespace geo
+{
+class shape2D;
+}
+
+namespace geo::stats
+{
+struct histogram
+{
+    static inline constexpr std::size_t BINS = 64;
+
+    // The last bin accumulates every value that does not fit in the previous ones
+    std::array<std::uint64_t, BINS> bins{};
+    std::uint64_t samples = 0;
+    std::uint64_t total = 0;
+    std::uint32_t max = 0;
+
+    void add(std::uint32_t value);
+    float mean() const;
+};
+
+struct gjk_stats
+{
+    std::uint64_t calls = 0;
+    std::uint64_t intersections = 0;
+    std::uint64_t support_evaluations = 0;
+    histogram iterations;
+};
+
+struct epa_stats
+{
+    std::uint64_t calls = 0;
+    std::uint64_t valid = 0;
+    std::uint64_t early_exits = 0;
+    std::uint64_t support_evaluations = 0;
+    histogram iterations;
+    histogram polytope_size;
+};
+
+struct sat_stats
+{
+    std::uint64_t calls = 0;
+    std::uint64_t intersections = 0;
+    std::uint64_t cache_exits = 0;
+    histogram axes_tested;
+};
+
+struct clipping_stats
+{
+    std::uint64_t calls = 0;
+    std::uint64_t contacts = 0;
+    histogram contacts_per_call;
+};
+
+struct contact_point_stats
+{
+    std::uint64_t calls = 0;
+    std::uint64_t support_evaluations = 0;
+};
+
+struct pair_stats
+{
+    std::string shape1;
+    std::string shape2;
+
+    gjk_stats gjk;
+    epa_stats epa;
+    sat_stats sat;
+    clipping_stats clipping;
+    contact_point_stats contact_point;
+};
+
+void record_gjk(const shape2D &sh1, const shape2D &sh2, std::uint32_t iterations, std::uint32_t support_evaluations,
+                bool intersect);
+void record_epa(const shape2D &sh1, const shape2D &sh2, std::uint32_t iterations, std::uint32_t polytope_size,
+                std::uint32_t support_evaluations, bool early_exit, bool valid);
+void record_sat(const shape2D &sh1, const shape2D &sh2, std::uint32_t axes_tested, bool cache_exit, bool intersect);
+void record_clipping(const shape2D &sh1, const shape2D &sh2, std::uint32_t contacts);
+void record_contact_point(const shape2D &sh1, const shape2D &sh2, std::uint32_t support_evaluations);
+
+// Merges the statistics recorded by every thread
+std::vector<pair_stats> snapshot();
+void reset();
+
+void dump_json(std::ostream &stream);
+} // namespace geo::stats
+#endif
@@ -0,0 +1,82 @@
+#pragma once
+
+#ifdef GEO_ENABLE_TIMELINE
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+#define GEO_TIMELINE_CONCAT_IMPL(a, b) a##b
+#define GEO_TIMELINE_CONCAT(a, b) GEO_TIMELINE_CONCAT_IMPL(a, b)
+#define GEO_TIMELINE_SCOPE(cat, name)                                                                                  \
+    const geo::timeline::scope GEO_TIMELINE_CONCAT(geo_timeline_scope, __LINE__)(geo::timeline::cat, name);
+#define GEO_TIMELINE_FUNCTION(cat) GEO_TIMELINE_SCOPE(cat, __func__)
+#else
+#define GEO_TIMELINE_SCOPE(cat, name)
+#define GEO_TIMELINE_FUNCTION(cat)
+#endif
+
+#ifdef GEO_ENABLE_TIMELINE
+// Timeline of the geometry hot paths, meant to spot thread imbalance and stalls across a frame. Every scope records its
+// begin and end timestamps as a single event into a ring buffer owned by the calling thread, with no locks nor
+// allocations, so that the oldest events are overwritten once a ring is full. Rings of finished threads are handed to
+// the next new thread, which keeps the amount of rings bounded by the peak amount of threads. The events are exported
+// in the Chrome trace event format, readable by chrome://tracing or Perfetto. Recording is disabled until enable() is
+// called, and a disabled scope costs a relaxed atomic load
+namespace geo::timeline
+{
+enum class category : std::uint8_t
+{
+    BROAD_PHASE,
+    NARROW_PHASE,
+    TRANSFORM,
+    SERIALIZATION
+};
+inline constexpr category BROAD_PHASE = category::BROAD_PHASE;
+inline constexpr category NARROW_PHASE = category::NARROW_PHASE;
+inline constexpr category TRANSFORM = category::TRANSFORM;
+inline constexpr category SERIALIZATION = category::SERIALIZATION;
+
+// Events kept per thread. Must be a power of 2
+inline constexpr std::size_t RING_CAPACITY = 1 << 15;
+
+const char *category_name(category cat);
+
+void enable(bool enabled = true);
+bool enabled();
+
+// Events recorded before the call are left out of the next exports
+void clear();
+// Events overwritten before being exported since the last clear
+std::uint64_t overwritten();
+
+// Other threads may keep recording while exporting. Events they overwrite while being read are left out
+void export_chrome_trace(std::ostream &stream);
+bool export_chrome_trace(const std::string &path);
+
+// Timestamp in nanoseconds of the steady clock
+std::uint64_t now();
+// name must outlive the export, such as a string literal
+void record(category cat, const char *name, std::uint64_t begin, std::uint64_t end);
+
+class scope
+{
+  public:
+    scope(const category cat, const char *name) : m_name(name), m_category(cat), m_begin(enabled() ? now() : 0)
+    {
+    }
+    ~scope()
+    {
+        if (m_begin != 0)
+            record(m_category, m_name, m_begin, now());
+    }
+
+    scope(const scope &) = delete;
+    scope &operator=(const scope &) = delete;
+
+  private:
+    const char *m_name;
+    category m_category;
+    std::uint64_t m_begin;
+};
+} // namespace geo::timeline
+#endif
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "kit/utility/transform.hpp"
+#include <glm/vec2.hpp>
+#include <glm/mat3x3.hpp>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Binary format written by the query recorder (see recorder.hpp) and read back by the replay tool. Values are stored
+// with their native size and byte order. A trace is a header followed by records, each starting with its kind:
+//  - shape: id, type, radius, length and model vertices. Emitted once per tracked shape, before any query using it
+//  - query: the kind of query, both shape ids, their poses and the thresholds the query was called with
+namespace geo::trace
+{
+inline constexpr std::uint32_t MAGIC = 0x43525447; // "GTRC"
+inline constexpr std::uint32_t VERSION = 1;
+
+enum class record_kind : std::uint8_t
+{
+    SHAPE = 0,
+    QUERY = 1
+};
+
+enum class shape_type : std::uint8_t
+{
+    CIRCLE = 0,
+    CAPSULE = 1,
+    POLYGON = 2
+};
+
+enum class query_type : std::uint8_t
+{
+    GJK = 0,
+    EPA = 1,
+    GJK_DISTANCE = 2,
+    ROUNDED_MTV = 3,
+    CONTACT_POINT = 4,
+    SAT = 5,
+    CLIPPING = 6
+};
+
+// Polygon vertices are the counter-clockwise model vertices, centered on the centroid. A non zero radius sweeps them
+// as in rounded_polygon
+struct shape_geometry
+{
+    shape_type type;
+    float radius = 0.f;
+    float length = 0.f;
+    std::vector<glm::vec2> vertices;
+};
+
+// The local transform without its parent pointer. Shapes with a parent also store the global transform of the parent
+struct pose
+{
+    kit::transform2D<float> ltransform;
+    bool has_parent = false;
+    glm::mat3 parent{1.f};
+};
+
+struct query
+{
+    query_type type;
+    std::uint32_t shape1;
+    std::uint32_t shape2;
+    pose pose1;
+    pose pose2;
+
+    // EPA and rounded_mtv
+    float threshold = 0.f;
+    // EPA called with a bare simplex instead of a gjk result
+    bool from_simplex = false;
+    std::array<glm::vec2, 3> simplex{};
+
+    // gjk_distance
+    std::uint32_t max_iterations = 0;
+
+    // mtv_support_contact_point and clipping_contacts
+    glm::vec2 mtv{0.f};
+
+    // SAT cache state before the query
+    bool has_cache = false;
+    bool cache_valid = false;
+    bool cache_poly1_reference = true;
+    std::uint32_t cache_normal_index = 0;
+
+    // clipping_contacts reference face, its flag and template argument
+    bool poly1_reference = true;
+    std::uint32_t normal_index = 0;
+    bool include_intersections = true;
+    std::uint32_t max_points = 0;
+};
+
+struct trace
+{
+    std::unordered_map<std::uint32_t, shape_geometry> shapes;
+    std::vector<query> queries;
+};
+
+const char *query_name(query_type type);
+
+void write_header(std::vector<char> &buffer);
+void write_shape(std::vector<char> &buffer, std::uint32_t id, const shape_geometry &geometry);
+void write_query(std::vector<char> &buffer, const query &qry);
+
+// Returns false if the file cannot be opened, is not a trace or is truncated before its first record. A record cut
+// short at the end of the file, as left by a process that did not stop the recorder, is ignored
+bool load(const std::string &path, trace &tr);
+} // namespace geo::trace
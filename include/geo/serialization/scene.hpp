@@ -0,0 +1,342 @@
+#pragma once
+#ifdef KIT_USE_YAML_CPP
+
+#include "geo/serialization/serialization.hpp"
+#include "geo/shapes2D/shape_array.hpp"
+#include "geo/shapes2D/polygon.hpp"
+#include "geo/shapes2D/rounded_polygon.hpp"
+#include "geo/shapes2D/static_polygon.hpp"
+#include "geo/shapes2D/compound.hpp"
+#include "geo/profiling/timeline.hpp"
+#include <array>
+#include <memory>
+#include <span>
+#include <tuple>
+#include <vector>
+
+namespace geo
+{
+// Key of the sequence holding the shapes of each type in a scene document. Specialize it to tell apart several
+// capacities of the same polygon type
+template <class Shape> struct scene_key;
+template <> struct scene_key<circle>
+{
+    static inline constexpr const char *value = "Circles";
+};
+template <> struct scene_key<capsule>
+{
+    static inline constexpr const char *value = "Capsules";
+};
+template <> struct scene_key<dynamic_polygon>
+{
+    static inline constexpr const char *value = "DynamicPolygons";
+};
+template <std::size_t Capacity> struct scene_key<polygon<Capacity>>
+{
+    static inline constexpr const char *value = "Polygons";
+};
+template <std::size_t Capacity> struct scene_key<rounded_polygon<Capacity>>
+{
+    static inline constexpr const char *value = "RoundedPolygons";
+};
+template <std::size_t Capacity> struct scene_key<static_polygon<Capacity>>
+{
+    static inline constexpr const char *value = "StaticPolygons";
+};
+template <std::size_t Capacity> struct scene_key<compound<Capacity>>
+{
+    static inline constexpr const char *value = "Compounds";
+};
+
+// Shapes of one type as parsed from the document. YAML nodes are not safe to read from several threads, so the whole
+// document is parsed first and the shapes are then constructed from this data alone. Vertices of every shape are
+// stored in a single buffer, and compounds store the vertex count of each of their pieces
+struct scene_shape
+{
+    kit::transform2D<float> transform;
+    std::uint32_t first = 0;
+    std::uint32_t count = 0;
+    std::uint32_t first_piece = 0;
+    std::uint32_t pieces = 0;
+    float radius = 0.f;
+    float length = 0.f;
+};
+struct scene_data
+{
+    std::vector<scene_shape> shapes;
+    std::vector<glm::vec2> vertices;
+    std::vector<std::uint32_t> piece_sizes;
+
+    std::span<const glm::vec2> vertices_of(const scene_shape &shape) const
+    {
+        return std::span<const glm::vec2>(vertices).subspan(shape.first, shape.count);
+    }
+};
+
+// Appends the vertices of a sequence node, failing if their amount is not in [3, max_vertices]
+inline bool parse_scene_vertices(const YAML::Node &node, scene_data &data, const std::size_t max_vertices)
+{
+    if (!node.IsSequence() || node.size() < 3 || node.size() > max_vertices)
+        return false;
+    for (std::size_t i = 0; i < node.size(); i++)
+        data.vertices.push_back(node[i].as<glm::vec2>());
+    return true;
+}
+
+// Reads a shape node with the layout of its codec, and constructs the shape from the parsed data at uninitialized
+// storage. Construction is called from several threads
+template <class Shape> struct scene_builder;
+
+template <> struct scene_builder<circle>
+{
+    static bool parse(const YAML::Node &node, scene_data &data)
+    {
+        if (!node.IsMap() || node.size() != 2)
+            return false;
+        data.shapes.push_back({.transform = node["Transform"].as<kit::transform2D<float>>(),
+                               .radius = node["Radius"].as<float>()});
+        return true;
+    }
+    static void construct(circle *at, const scene_shape &shape, const scene_data &)
+    {
+        std::construct_at(at, shape.transform, shape.radius);
+    }
+};
+
+template <> struct scene_builder<capsule>
+{
+    static bool parse(const YAML::Node &node, scene_data &data)
+    {
+        if (!node.IsMap() || node.size() != 3)
+            return false;
+        data.shapes.push_back({.transform = node["Transform"].as<kit::transform2D<float>>(),
+                               .radius = node["Radius"].as<float>(),
+                               .length = node["Length"].as<float>()});
+        return true;
+    }
+    static void construct(capsule *at, const scene_shape &shape, const scene_data &)
+    {
+        std::construct_at(at, shape.transform, shape.length, shape.radius);
+    }
+};
+
+// Shared by every type whose node holds a transform, its vertices and optionally a radius
+template <std::size_t MaxVertices, bool Rounded> struct scene_polygon_parser
+{
+    static bool parse(const YAML::Node &node, scene_data &data)
+    {
+        if (!node.IsMap() || node.size() != (Rounded ? 3 : 2))
+            return false;
+        scene_shape shape{.transform = node["Transform"].as<kit::transform2D<float>>(),
+                          .first = (std::uint32_t)data.vertices.size()};
+        if (!parse_scene_vertices(node["Vertices"], data, MaxVertices))
+            return false;
+        shape.count = (std::uint32_t)data.vertices.size() - shape.first;
+        if constexpr (Rounded)
+            shape.radius = node["Radius"].as<float>();
+        data.shapes.push_back(shape);
+        return true;
+    }
+};
+
+template <std::size_t Capacity>
+struct scene_builder<polygon<Capacity>> : scene_polygon_parser<Capacity, false>
+{
+    static void construct(polygon<Capacity> *at, const scene_shape &shape, const scene_data &data)
+    {
+        const std::span<const glm::vec2> vertices = data.vertices_of(shape);
+        std::construct_at(at, shape.transform, vertices.begin(), vertices.end());
+    }
+};
+
+template <> struct scene_builder<dynamic_polygon> : scene_polygon_parser<SIZE_MAX, false>
+{
+    static void construct(dynamic_polygon *at, const scene_shape &shape, const scene_data &data)
+    {
+        std::construct_at(at, shape.transform, data.vertices_of(shape));
+    }
+};
+
+template <std::size_t Capacity>
+struct scene_builder<rounded_polygon<Capacity>> : scene_polygon_parser<Capacity, true>
+{
+    static void construct(rounded_polygon<Capacity> *at, const scene_shape &shape, const scene_data &data)
+    {
+        const std::span<const glm::vec2> vertices = data.vertices_of(shape);
+        kit::dynarray<glm::vec2, Capacity> verts{vertices.size()};
+        std::copy(vertices.begin(), vertices.end(), verts.begin());
+        std::construct_at(at, shape.transform, verts, shape.radius);
+    }
+};
+
+template <std::size_t Capacity>
+struct scene_builder<static_polygon<Capacity>> : scene_polygon_parser<Capacity, false>
+{
+    static void construct(static_polygon<Capacity> *at, const scene_shape &shape, const scene_data &data)
+    {
+        const std::span<const glm::vec2> vertices = data.vertices_of(shape);
+        std::construct_at(at, polygon<Capacity>(shape.transform, vertices.begin(), vertices.end()));
+    }
+};
+
+template <std::size_t Capacity> struct scene_builder<compound<Capacity>>
+{
+    static bool parse(const YAML::Node &node, scene_data &data)
+    {
+        if (!node.IsMap() || node.size() != 2)
+            return false;
+        const YAML::Node node_p = node["Pieces"];
+        if (!node_p.IsSequence() || node_p.size() == 0)
+            return false;
+
+        scene_shape shape{.transform = node["Transform"].as<kit::transform2D<float>>(),
+                          .first = (std::uint32_t)data.vertices.size(),
+                          .first_piece = (std::uint32_t)data.piece_sizes.size(),
+                          .pieces = (std::uint32_t)node_p.size()};
+        for (std::size_t i = 0; i < node_p.size(); i++)
+        {
+            const std::size_t size = data.vertices.size();
+            if (!parse_scene_vertices(node_p[i], data, Capacity))
+                return false;
+            data.piece_sizes.push_back((std::uint32_t)(data.vertices.size() - size));
+        }
+        shape.count = (std::uint32_t)data.vertices.size() - shape.first;
+        data.shapes.push_back(shape);
+        return true;
+    }
+    static void construct(compound<Capacity> *at, const scene_shape &shape, const scene_data &data)
+    {
+        std::vector<std::vector<glm::vec2>> pieces(shape.pieces);
+        const glm::vec2 *vertex = data.vertices.data() + shape.first;
+        for (std::uint32_t i = 0; i < shape.pieces; i++)
+        {
+            const std::uint32_t size = data.piece_sizes[shape.first_piece + i];
+            pieces[i].assign(vertex, vertex + size);
+            vertex += size;
+        }
+        std::construct_at(at, shape.transform, std::span<const std::vector<glm::vec2>>(pieces));
+    }
+};
+
+struct scene_settings
+{
+    // Zero uses the hardware concurrency
+    std::uint32_t threads = 0;
+    // Shapes constructed by a thread each time it picks work
+    std::uint32_t chunk = 64;
+};
+
+// Static scene content, with the shapes of each type stored contiguously in a shape_array
+template <class... Shapes> class scene
+{
+  public:
+    template <class Shape> shape_array<Shape> &shapes()
+    {
+        return std::get<shape_array<Shape>>(m_arrays);
+    }
+    template <class Shape> const shape_array<Shape> &shapes() const
+    {
+        return std::get<shape_array<Shape>>(m_arrays);
+    }
+
+    // Calls fun with every shape, one type after the other, with its concrete type
+    template <class F> void for_each(F &&fun)
+    {
+        std::apply([&fun](auto &...arrays) { (for_each_in(arrays, fun), ...); }, m_arrays);
+    }
+    template <class F> void for_each(F &&fun) const
+    {
+        std::apply([&fun](const auto &...arrays) { (for_each_in(arrays, fun), ...); }, m_arrays);
+    }
+
+    std::size_t size() const
+    {
+        return (shapes<Shapes>().size() + ... + 0);
+    }
+    void clear()
+    {
+        (shapes<Shapes>().clear(), ...);
+    }
+
+  private:
+    std::tuple<shape_array<Shapes>...> m_arrays;
+
+    template <class Array, class F> static void for_each_in(Array &array, F &fun)
+    {
+        for (auto &shape : array)
+            fun(shape);
+    }
+};
+
+// The document is a map from the scene_key of each shape type to the sequence of its shapes, each with the layout of
+// its codec. Types missing from the document are left empty. The document is parsed once on the calling thread, and
+// the shapes are then constructed in parallel directly in their final storage. Returns false, leaving the scene
+// untouched, if any shape node is malformed, such as a missing key or a value of the wrong type. The shapes are built
+// in a separate scene that only replaces scn once every shape is constructed, so a throwing construction also leaves
+// scn untouched
+template <class... Shapes>
+bool load_scene(const YAML::Node &node, scene<Shapes...> &scn, const scene_settings &settings = {})
+{
+    KIT_PERF_FUNCTION()
+    GEO_TIMELINE_FUNCTION(SERIALIZATION)
+    if (!node.IsMap())
+        return false;
+
+    std::array<scene_data, sizeof...(Shapes)> data;
+    const auto parse = [&node]<class Shape>(scene_data &shape_data) {
+        const YAML::Node node_s = node[scene_key<Shape>::value];
+        if (!node_s)
+            return true;
+        if (!node_s.IsSequence())
+            return false;
+        shape_data.shapes.reserve(node_s.size());
+        for (std::size_t i = 0; i < node_s.size(); i++)
+            if (!scene_builder<Shape>::parse(node_s[i], shape_data))
+                return false;
+        return true;
+    };
+
+    // Reading a missing key or a value of the wrong type throws
+    bool parsed;
+    try
+    {
+        parsed = std::apply(
+            [&parse](auto &...shape_data) { return (parse.template operator()<Shapes>(shape_data) && ...); }, data);
+    }
+    catch (const YAML::Exception &)
+    {
+        return false;
+    }
+    if (!parsed)
+        return false;
+
+    scene<Shapes...> loaded;
+    std::apply(
+        [&loaded, &settings](const auto &...shape_data) {
+            (loaded.template shapes<Shapes>().build(
+                 shape_data.shapes.size(),
+                 [&shape_data](const std::size_t i, Shapes *at) {
+                     scene_builder<Shapes>::construct(at, shape_data.shapes[i], shape_data);
+                 },
+                 settings.threads, settings.chunk),
+             ...);
+        },
+        data);
+    scn = std::move(loaded);
+    return true;
+}
+
+template <class... Shapes> YAML::Node encode_scene(const scene<Shapes...> &scn)
+{
+    KIT_PERF_FUNCTION()
+    GEO_TIMELINE_FUNCTION(SERIALIZATION)
+    YAML::Node node;
+    const auto encode = [&node]<class Shape>(const shape_array<Shape> &array) {
+        for (const Shape &shape : array)
+            node[scene_key<Shape>::value].push_back(kit::yaml::codec<Shape>::encode(shape));
+    };
+    (encode(scn.template shapes<Shapes>()), ...);
+    return node;
+}
+} // namespace geo
+#endif
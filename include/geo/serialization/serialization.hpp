@@ -2,6 +2,8 @@
 #ifdef KIT_USE_YAML_CPP
 
 #include "geo/shapes2D/circle.hpp"
+#include "geo/shapes2D/capsule.hpp"
+#include "geo/shapes2D/dynamic_polygon.hpp"
 #include "geo/shapes2D/vertices2D.hpp"
 #include "kit/serialization/yaml/codec.hpp"
 #include "kit/serialization/yaml/glm.hpp"
@@ -10,6 +12,9 @@
 namespace geo
 {
 template <std::size_t Capacity> class polygon;
+template <std::size_t Capacity> class compound;
+template <std::size_t Capacity> class rounded_polygon;
+template <std::size_t Capacity> class static_polygon;
 }
 
 template <> struct kit::yaml::codec<geo::aabb2D>
@@ -52,6 +57,26 @@ template <> struct kit::yaml::codec<geo::circle>
     }
 };
 
+template <> struct kit::yaml::codec<geo::capsule>
+{
+    static YAML::Node encode(const geo::capsule &cap)
+    {
+        YAML::Node node;
+        node["Transform"] = cap.ltransform();
+        node["Length"] = cap.length();
+        node["Radius"] = cap.radius();
+
+        return node;
+    }
+    static bool decode(const YAML::Node &node, geo::capsule &cap)
+    {
+        if (!node.IsMap() || node.size() != 3)
+            return false;
+        cap = {node["Transform"].as<kit::transform2D<float>>(), node["Length"].as<float>(), node["Radius"].as<float>()};
+        return true;
+    }
+};
+
 template <std::size_t Capacity> struct kit::yaml::codec<geo::polygon<Capacity>>
 {
     static YAML::Node encode(const geo::polygon<Capacity> &poly)
@@ -81,4 +106,131 @@ template <std::size_t Capacity> struct kit::yaml::codec<geo::polygon<Capacity>>
         return true;
     }
 };
+
+template <> struct kit::yaml::codec<geo::dynamic_polygon>
+{
+    static YAML::Node encode(const geo::dynamic_polygon &poly)
+    {
+        YAML::Node node;
+        node["Transform"] = poly.ltransform();
+
+        for (std::size_t i = 0; i < poly.vertices.size(); i++)
+        {
+            node["Vertices"].push_back(poly.vertices.locals[i]);
+            node["Vertices"][i].SetStyle(YAML::EmitterStyle::Flow);
+        }
+        return node;
+    }
+    static bool decode(const YAML::Node &node, geo::dynamic_polygon &poly)
+    {
+        if (!node.IsMap() || node.size() != 2)
+            return false;
+        YAML::Node node_v = node["Vertices"];
+
+        std::vector<glm::vec2> vertices(node_v.size());
+        for (std::size_t i = 0; i < node_v.size(); i++)
+            vertices[i] = node_v[i].as<glm::vec2>();
+
+        const kit::transform2D<float> transform = node["Transform"].as<kit::transform2D<float>>();
+        poly = geo::dynamic_polygon(transform, vertices, poly.resource());
+        return true;
+    }
+};
+
+template <std::size_t Capacity> struct kit::yaml::codec<geo::rounded_polygon<Capacity>>
+{
+    static YAML::Node encode(const geo::rounded_polygon<Capacity> &poly)
+    {
+        YAML::Node node;
+        node["Transform"] = poly.ltransform();
+
+        for (std::size_t i = 0; i < poly.core.size(); i++)
+        {
+            node["Vertices"].push_back(poly.core.locals[i]);
+            node["Vertices"][i].SetStyle(YAML::EmitterStyle::Flow);
+        }
+        node["Radius"] = poly.radius();
+        return node;
+    }
+    static bool decode(const YAML::Node &node, geo::rounded_polygon<Capacity> &poly)
+    {
+        if (!node.IsMap() || node.size() != 3)
+            return false;
+        YAML::Node node_v = node["Vertices"];
+
+        kit::dynarray<glm::vec2, Capacity> vertices{node_v.size()};
+        for (std::size_t i = 0; i < node_v.size(); i++)
+            vertices[i] = node_v[i].as<glm::vec2>();
+
+        const kit::transform2D<float> transform = node["Transform"].as<kit::transform2D<float>>();
+        poly = {transform, vertices, node["Radius"].as<float>()};
+        return true;
+    }
+};
+
+template <std::size_t Capacity> struct kit::yaml::codec<geo::static_polygon<Capacity>>
+{
+    static YAML::Node encode(const geo::static_polygon<Capacity> &poly)
+    {
+        YAML::Node node;
+        node["Transform"] = poly.ltransform();
+
+        for (std::size_t i = 0; i < poly.vertices.size(); i++)
+        {
+            node["Vertices"].push_back(poly.decode_model(i));
+            node["Vertices"][i].SetStyle(YAML::EmitterStyle::Flow);
+        }
+        return node;
+    }
+    static bool decode(const YAML::Node &node, geo::static_polygon<Capacity> &poly)
+    {
+        if (!node.IsMap() || node.size() != 2)
+            return false;
+        YAML::Node node_v = node["Vertices"];
+
+        kit::dynarray<glm::vec2, Capacity> vertices{node_v.size()};
+        for (std::size_t i = 0; i < node_v.size(); i++)
+            vertices[i] = node_v[i].as<glm::vec2>();
+
+        const kit::transform2D<float> transform = node["Transform"].as<kit::transform2D<float>>();
+        poly = geo::static_polygon<Capacity>(geo::polygon<Capacity>(transform, vertices));
+        return true;
+    }
+};
+
+template <std::size_t Capacity> struct kit::yaml::codec<geo::compound<Capacity>>
+{
+    static YAML::Node encode(const geo::compound<Capacity> &comp)
+    {
+        YAML::Node node;
+        node["Transform"] = comp.ltransform();
+
+        for (const geo::polygon<Capacity> &child : comp.children())
+        {
+            YAML::Node node_p;
+            for (std::size_t i = 0; i < child.vertices.size(); i++)
+            {
+                node_p.push_back(child.vertices.locals[i]);
+                node_p[i].SetStyle(YAML::EmitterStyle::Flow);
+            }
+            node["Pieces"].push_back(node_p);
+        }
+        return node;
+    }
+    static bool decode(const YAML::Node &node, geo::compound<Capacity> &comp)
+    {
+        if (!node.IsMap() || node.size() != 2)
+            return false;
+        YAML::Node node_p = node["Pieces"];
+
+        std::vector<std::vector<glm::vec2>> pieces{node_p.size()};
+        for (std::size_t i = 0; i < node_p.size(); i++)
+            for (std::size_t j = 0; j < node_p[i].size(); j++)
+                pieces[i].push_back(node_p[i][j].as<glm::vec2>());
+
+        const kit::transform2D<float> transform = node["Transform"].as<kit::transform2D<float>>();
+        comp = geo::compound<Capacity>(transform, pieces);
+        return true;
+    }
+};
 #endif
\ No newline at end of file
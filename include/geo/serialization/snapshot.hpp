@@ -0,0 +1,117 @@
+#pragma once
+
+#include "geo/shapes2D/shape2D.hpp"
+#include <vector>
+#include <array>
+#include <span>
+#include <cstdint>
+
+namespace geo
+{
+class bit_writer
+{
+  public:
+    void write(std::uint32_t value, std::uint32_t bits);
+    void clear();
+
+    const std::vector<std::uint8_t> &bytes() const;
+    std::size_t bit_count() const;
+
+  private:
+    std::vector<std::uint8_t> m_bytes;
+    std::size_t m_bits = 0;
+};
+
+class bit_reader
+{
+  public:
+    bit_reader(std::span<const std::uint8_t> bytes);
+
+    // Returns false if there are not enough bits left, in which case value is left untouched
+    bool read(std::uint32_t &value, std::uint32_t bits);
+
+  private:
+    std::span<const std::uint8_t> m_bytes;
+    std::size_t m_bit = 0;
+};
+
+// Encoder and decoder must share the same settings. Precisions are the size of one quantization step, with rotations
+// in radians
+struct snapshot_settings
+{
+    float position_precision = 1.e-3f;
+    float rotation_precision = 1.e-4f;
+    float scale_precision = 1.e-3f;
+    // Snapshots kept as possible baselines: by the encoder until they are acknowledged, and by the decoder once decoded
+    std::uint32_t history = 32;
+};
+
+// Position, rotation, scale and origin of a local transform in quantization steps
+struct quantized_transform
+{
+    std::array<std::int32_t, 7> values{};
+
+    bool operator==(const quantized_transform &other) const = default;
+};
+
+// Quantized transforms of every shape as of the snapshot with the given sequence number. Sequence 0 means no snapshot
+struct snapshot_state
+{
+    std::uint32_t sequence = 0;
+    std::vector<quantized_transform> transforms;
+};
+
+// Writes the local transforms of a collection of shapes as deltas against a baseline snapshot. Only the transform
+// components that changed by at least one quantization step are written, as variable length bit-packed integers.
+// Every snapshot carries its sequence number and the one of its baseline, so that the decoder rejects snapshots it
+// cannot apply. Parents are not part of the snapshot
+class snapshot_encoder
+{
+  public:
+    snapshot_encoder(const snapshot_settings &settings = {});
+
+    // A keyframe encodes every transform against an all-zero baseline, so that it can be decoded without any previous
+    // snapshot. A change in the amount of shapes, or having no baseline, always produces a keyframe
+    const std::vector<std::uint8_t> &encode(std::span<const shape2D *const> shapes, bool keyframe = false);
+
+    // Deltas are encoded against the previous snapshot, which requires a reliable and ordered channel, until the first
+    // call. From then on, they are encoded against the latest snapshot the decoder acknowledged, so that snapshots may
+    // be lost or reordered. Sequences that are unknown or older than the current baseline are ignored
+    void acknowledge(std::uint32_t sequence);
+
+    // Sequence of the last encoded snapshot. Snapshots are numbered from 1
+    std::uint32_t sequence() const;
+    const snapshot_settings &settings() const;
+
+  private:
+    snapshot_settings m_settings;
+    std::uint32_t m_sequence = 0;
+    bool m_acknowledged = false;
+
+    snapshot_state m_baseline;
+    std::vector<snapshot_state> m_unacknowledged;
+    bit_writer m_writer;
+};
+
+// Applies snapshots newer than the last decoded one. Shapes must be given in the same order as to the encoder, and only
+// the ones that changed are updated, once each, through begin_update and end_update
+class snapshot_decoder
+{
+  public:
+    snapshot_decoder(const snapshot_settings &settings = {});
+
+    // Returns false if the snapshot is truncated, does not match the amount of shapes, is not newer than the last
+    // decoded snapshot, or is a delta against a snapshot that was not decoded or is no longer kept. Shapes preceding a
+    // truncation may have been updated already, but the decoded snapshots stay usable as baselines
+    bool decode(std::span<const std::uint8_t> snapshot, std::span<shape2D *const> shapes);
+
+    // Sequence of the last decoded snapshot, to acknowledge to the encoder. 0 if there is none
+    std::uint32_t sequence() const;
+    const snapshot_settings &settings() const;
+
+  private:
+    snapshot_settings m_settings;
+    // Decoded snapshots that may still be used as baselines, oldest first
+    std::vector<snapshot_state> m_states;
+};
+} // namespace geo
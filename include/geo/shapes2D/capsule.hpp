@@ -0,0 +1,49 @@
+#pragma once
+
+#include "geo/shapes2D/shape2D.hpp"
+#include <array>
+
+namespace geo
+{
+// Segment of the given length along the local x axis, swept by a disk of the given radius. As with circle, the radius
+// is not affected by the scale of the transform
+class capsule final : public shape2D
+{
+  public:
+    capsule(float length = 1.f, float radius = 0.5f);
+    capsule(const kit::transform2D<float> &ltransform, float length = 1.f, float radius = 0.5f);
+
+    float length() const;
+    void length(float length);
+
+    float radius() const;
+    void radius(float radius);
+
+    // Global endpoints of the core segment
+    const std::array<glm::vec2, 2> &segment() const;
+    glm::vec2 closest_segment_point(const glm::vec2 &p) const;
+
+    glm::vec2 support_point(const glm::vec2 &direction) const override;
+    bool contains_point(const glm::vec2 &p) const override;
+
+    void bound() override;
+
+    glm::vec2 closest_direction_from(const glm::vec2 &p) const override;
+
+    glm::vec2 core_support_point(const glm::vec2 &direction) const override;
+    float core_radius() const override;
+
+#ifdef KIT_USE_YAML_CPP
+    YAML::Node encode() const override;
+    bool decode(const YAML::Node &node) override;
+#endif
+
+  private:
+    float m_length;
+    float m_radius;
+    std::array<glm::vec2, 2> m_segment;
+
+    void update_area_and_inertia();
+    void on_shape_transform_update(const glm::mat3 &ltransform, const glm::mat3 &gtransform) override;
+};
+} // namespace geo
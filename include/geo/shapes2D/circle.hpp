@@ -20,6 +20,9 @@ class circle final : public shape2D
 
     glm::vec2 closest_direction_from(const glm::vec2 &p) const override;
 
+    glm::vec2 core_support_point(const glm::vec2 &direction) const override;
+    float core_radius() const override;
+
 #ifdef KIT_USE_YAML_CPP
     YAML::Node encode() const override;
     bool decode(const YAML::Node &node) override;
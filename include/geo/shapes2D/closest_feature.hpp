@@ -0,0 +1,201 @@
+#pragma once
+
+#include "geo/shapes2D/polygon_geometry.hpp"
+#include "kit/utility/utils.hpp"
+#include <glm/vec2.hpp>
+#include <glm/geometric.hpp>
+#include <algorithm>
+#include <cfloat>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace geo
+{
+enum class polygon_feature : std::uint8_t
+{
+    VERTEX,
+    EDGE
+};
+
+struct closest_feature
+{
+    // From the point to the closest point of the boundary, as closest_direction_from
+    glm::vec2 direction{0.f};
+    // Vertex index, or edge index where edge i joins vertex i to vertex i + 1
+    std::uint32_t index = 0;
+    polygon_feature type = polygon_feature::VERTEX;
+};
+
+// Below this amount of vertices scanning every edge is faster than the binary searches
+inline constexpr std::size_t closest_feature_search_threshold = 16;
+
+// Checks every edge. Works with any vertex container exposing size(), globals and normals, and with non convex polygons
+template <class Vertices> closest_feature closest_feature_linear(const Vertices &vertices, const glm::vec2 &p)
+{
+    const std::size_t size = vertices.size();
+    closest_feature closest;
+    float min_dist = FLT_MAX;
+    for (std::size_t i = 0; i < size; i++)
+    {
+        const glm::vec2 current = vertices.globals[i];
+        const glm::vec2 edge = vertices.globals[i + 1] - current;
+        const float along = std::clamp(glm::dot(p - current, edge) / glm::dot(edge, edge), 0.f, 1.f);
+        const glm::vec2 towards = current + along * edge - p;
+        const float dist = glm::dot(towards, towards);
+        if (min_dist > dist)
+        {
+            min_dist = dist;
+            if (along == 0.f)
+                closest = {towards, (std::uint32_t)i, polygon_feature::VERTEX};
+            else if (along == 1.f)
+                closest = {towards, (std::uint32_t)((i + 1) % size), polygon_feature::VERTEX};
+            else
+                closest = {towards, (std::uint32_t)i, polygon_feature::EDGE};
+        }
+    }
+    return closest;
+}
+
+// Whether p lies inside of a convex, counter-clockwise polygon or on its boundary, locating p in the fan of triangles
+// around vertex 0 with a binary search
+template <class Vertices> bool convex_contains_point(const Vertices &vertices, const glm::vec2 &p)
+{
+    const std::size_t size = vertices.size();
+    const glm::vec2 origin = vertices.globals[0];
+    const glm::vec2 rel = p - origin;
+    if (kit::cross2D(vertices.globals[1] - origin, rel) < 0.f ||
+        kit::cross2D(vertices.globals[size - 1] - origin, rel) > 0.f)
+        return false;
+
+    std::size_t lo = 1, hi = size - 1;
+    while (hi - lo > 1)
+    {
+        const std::size_t mid = (lo + hi) / 2;
+        if (kit::cross2D(vertices.globals[mid] - origin, rel) >= 0.f)
+            lo = mid;
+        else
+            hi = mid;
+    }
+    const glm::vec2 current = vertices.globals[lo];
+    return kit::cross2D(vertices.globals[lo + 1] - current, p - current) >= 0.f;
+}
+
+// The closest boundary point to a point inside of a convex polygon is its projection onto the closest edge line, which
+// always falls within the edge. The distance to the edge lines is not unimodal along the boundary, so every edge is
+// checked, although with a single dot product per edge
+template <class Vertices> closest_feature closest_feature_interior(const Vertices &vertices, const glm::vec2 &p)
+{
+    closest_feature closest{glm::vec2(0.f), 0, polygon_feature::EDGE};
+    float min_dist = FLT_MAX;
+    for (std::size_t i = 0; i < vertices.size(); i++)
+    {
+        const glm::vec2 normal = vertices.normals[i];
+        const float dist = glm::dot(normal, vertices.globals[i] - p);
+        if (min_dist > dist)
+        {
+            min_dist = dist;
+            closest = {dist * normal, (std::uint32_t)i, polygon_feature::EDGE};
+        }
+    }
+    return closest;
+}
+
+// Edge normals of a convex polygon are sorted by angle. Any point of the polygon c gives a direction u = p - c within
+// 90 degrees of the direction from the closest point to p, so ordering the edges by normal angle starting opposite to
+// u, the edges whose normals face u and end before the closest point come first. Both the starting edge and that
+// boundary are found with binary searches, and the resulting vertex or edge is then checked against its Voronoi region.
+// Points inside the polygon, or on the boundary, are detected first and take the interior scan, which stays linear.
+// angle(i) must return the pseudo_angle of normal i minus the one of normal 0, wrapped to [0, 4)
+template <class Vertices, class Angle>
+closest_feature closest_feature_search(const Vertices &vertices, const glm::vec2 &p, const float angle0,
+                                       Angle &&angle)
+{
+    const std::size_t size = vertices.size();
+    const auto wrap = [](const float a) { return a < 0.f ? a + 4.f : a; };
+    if (convex_contains_point(vertices, p))
+        return closest_feature_interior(vertices, p);
+
+    const glm::vec2 u = p - 0.5f * (vertices.globals[0] + vertices.globals[size / 2]);
+
+    // First edge whose normal is at or after -u
+    const float target = wrap(pseudo_angle(-u) - angle0);
+    std::size_t lo = 0, hi = size;
+    while (lo < hi)
+    {
+        const std::size_t mid = (lo + hi) / 2;
+        if (angle(mid) < target)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    const std::size_t start = lo % size;
+
+    // Edges in the first half turn from -u that do not face u, and those in the second half turn that do face u and
+    // end before the closest point, come first
+    lo = 0;
+    hi = size;
+    while (lo < hi)
+    {
+        const std::size_t mid = (lo + hi) / 2;
+        const std::size_t i = (start + mid) % size;
+        const glm::vec2 end = vertices.globals[i + 1];
+        const glm::vec2 normal = vertices.normals[i];
+        const bool first_half = wrap(angle(i) - target) < 2.f;
+        const bool faces = glm::dot(normal, u) > 0.f;
+        const bool before = glm::dot(p - end, end - vertices.globals[i]) > 0.f;
+        if (first_half ? (before || !faces) : (before && faces))
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    const std::size_t i = (start + lo) % size;
+    const glm::vec2 current = vertices.globals[i];
+    const glm::vec2 edge = vertices.globals[i + 1] - current;
+    const glm::vec2 side = p - current;
+    const float along = glm::dot(side, edge);
+    if (along <= 0.f)
+    {
+        const glm::vec2 prev_edge = current - vertices.globals[i + size - 1];
+        if (glm::dot(side, prev_edge) >= 0.f && (side.x != 0.f || side.y != 0.f))
+            return {-side, (std::uint32_t)i, polygon_feature::VERTEX};
+    }
+    else if (along <= glm::dot(edge, edge) && kit::cross2D(edge, side) < 0.f)
+        return {current + (along / glm::dot(edge, edge)) * edge - p, (std::uint32_t)i, polygon_feature::EDGE};
+    return closest_feature_linear(vertices, p);
+}
+
+// Closest vertex or edge of a convex, counter-clockwise polygon to p in O(log n) for points outside of it and O(n) for
+// points inside, given its vertex container (vertices of a polygon or the core of a rounded polygon)
+template <class Vertices> closest_feature closest_feature_from(const Vertices &vertices, const glm::vec2 &p)
+{
+    const float angle0 = pseudo_angle(vertices.normals[0]);
+    return closest_feature_search(vertices, p, angle0, [&vertices, angle0](const std::size_t i) {
+        const float a = pseudo_angle(vertices.normals[i]) - angle0;
+        return a < 0.f ? a + 4.f : a;
+    });
+}
+
+// Batch variant, which computes the normal angles once for all points
+template <class Vertices>
+void closest_features_from(const Vertices &vertices, const std::span<const glm::vec2> points,
+                           const std::span<closest_feature> features)
+{
+    KIT_PERF_FUNCTION()
+    KIT_ASSERT_ERROR(features.size() >= points.size(),
+                     "Not enough room for the features: {0} points and room for {1} features", points.size(),
+                     features.size())
+    const float angle0 = pseudo_angle(vertices.normals[0]);
+    std::vector<float> angles(vertices.size());
+    for (std::size_t i = 0; i < angles.size(); i++)
+    {
+        const float a = pseudo_angle(vertices.normals[i]) - angle0;
+        angles[i] = a < 0.f ? a + 4.f : a;
+    }
+    angles[0] = 0.f;
+    for (std::size_t i = 0; i < points.size(); i++)
+        features[i] =
+            closest_feature_search(vertices, points[i], angle0, [&angles](const std::size_t j) { return angles[j]; });
+}
+} // namespace geo
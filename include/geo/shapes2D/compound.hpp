@@ -0,0 +1,326 @@
+#pragma once
+
+#include "geo/shapes2D/polygon.hpp"
+#include "geo/algorithm/decomposition.hpp"
+#include "geo/algorithm/intersection.hpp"
+#include "geo/serialization/serialization.hpp"
+#include <vector>
+#include <span>
+#include <type_traits>
+
+namespace geo
+{
+// A possibly concave shape made of convex polygon children that share the compound transform. The children bounding
+// boxes are kept in a small tree so that queries only visit the children that may be involved
+template <std::size_t Capacity> class compound final : public shape2D
+{
+  public:
+    compound(const std::span<const glm::vec2> outline)
+    {
+        m_ltransform.position = initialize_children(convex_decomposition(outline, Capacity));
+        update();
+    }
+    compound(const std::span<const std::vector<glm::vec2>> pieces)
+    {
+        m_ltransform.position = initialize_children(pieces);
+        update();
+    }
+    compound(const kit::transform2D<float> &ltransform, const std::span<const glm::vec2> outline)
+        : shape2D(ltransform)
+    {
+        initialize_children(convex_decomposition(outline, Capacity));
+        update();
+    }
+    compound(const kit::transform2D<float> &ltransform, const std::span<const std::vector<glm::vec2>> pieces)
+        : shape2D(ltransform)
+    {
+        initialize_children(pieces);
+        update();
+    }
+
+    compound(const compound &other) : shape2D(other), m_children(other.m_children), m_nodes(other.m_nodes)
+    {
+        reparent_children();
+    }
+    compound(compound &&other) noexcept
+        : shape2D(std::move(other)), m_children(std::move(other.m_children)), m_nodes(std::move(other.m_nodes))
+    {
+        reparent_children();
+    }
+
+    compound &operator=(const compound &other)
+    {
+        shape2D::operator=(other);
+        m_children = other.m_children;
+        m_nodes = other.m_nodes;
+        reparent_children();
+        return *this;
+    }
+    compound &operator=(compound &&other) noexcept
+    {
+        shape2D::operator=(std::move(other));
+        m_children = std::move(other.m_children);
+        m_nodes = std::move(other.m_nodes);
+        reparent_children();
+        return *this;
+    }
+
+    const std::vector<polygon<Capacity>> &children() const
+    {
+        return m_children;
+    }
+
+    // Calls fun for every child whose bounding box overlaps aabb. If fun returns a bool, returning true stops the
+    // traversal
+    template <class F> void query(const aabb2D &aabb, F &&fun) const
+    {
+        std::array<std::uint32_t, 64> stack;
+        std::size_t size = 0;
+        stack[size++] = 0;
+        while (size > 0)
+        {
+            const node &nd = m_nodes[stack[--size]];
+            if (!intersects(nd.aabb, aabb))
+                continue;
+            if (nd.child != NONE)
+            {
+                if constexpr (std::is_same_v<std::invoke_result_t<F, const polygon<Capacity> &>, bool>)
+                {
+                    if (fun(m_children[nd.child]))
+                        return;
+                }
+                else
+                    fun(m_children[nd.child]);
+                continue;
+            }
+            stack[size++] = nd.left;
+            stack[size++] = nd.right;
+        }
+    }
+
+    // Support point of the convex hull of all children. The generic queries relying on it (gjk, epa, rounded_mtv,
+    // gjk_distance) collide that hull, so concave compounds must be tested with the compound intersects and mtv below
+    glm::vec2 support_point(const glm::vec2 &direction) const override
+    {
+        glm::vec2 support = m_children[0].support_point(direction);
+        float max_dot = glm::dot(direction, support);
+        for (std::size_t i = 1; i < m_children.size(); i++)
+        {
+            const glm::vec2 sup = m_children[i].support_point(direction);
+            const float dot = glm::dot(direction, sup);
+            if (dot > max_dot)
+            {
+                max_dot = dot;
+                support = sup;
+            }
+        }
+        return support;
+    }
+
+    bool contains_point(const glm::vec2 &p) const override
+    {
+        bool contained = false;
+        query(aabb2D(p), [&p, &contained](const polygon<Capacity> &child) {
+            contained = child.contains_point(p);
+            return contained;
+        });
+        return contained;
+    }
+
+    glm::vec2 closest_direction_from(const glm::vec2 &p) const override
+    {
+        float min_dist = FLT_MAX;
+        glm::vec2 closest(0.f);
+        for (const polygon<Capacity> &child : m_children)
+        {
+            const glm::vec2 towards = child.closest_direction_from(p);
+            const float dist = glm::length2(towards);
+            if (min_dist > dist)
+            {
+                min_dist = dist;
+                closest = towards;
+            }
+        }
+        return closest;
+    }
+
+    void bound() override
+    {
+        for (std::size_t i = m_nodes.size(); i-- > 0;)
+        {
+            node &nd = m_nodes[i];
+            if (nd.child != NONE)
+                nd.aabb = m_children[nd.child].bounding_box();
+            else
+                nd.aabb = m_nodes[nd.left].aabb + m_nodes[nd.right].aabb;
+        }
+        m_aabb = m_nodes[0].aabb;
+    }
+
+#ifdef KIT_USE_YAML_CPP
+    YAML::Node encode() const override
+    {
+        return kit::yaml::codec<compound>::encode(*this);
+    }
+    bool decode(const YAML::Node &node) override
+    {
+        return kit::yaml::codec<compound>::decode(node, *this);
+    }
+#endif
+
+  private:
+    static inline constexpr std::uint32_t NONE = UINT32_MAX;
+    struct node
+    {
+        aabb2D aabb;
+        std::uint32_t left = NONE;
+        std::uint32_t right = NONE;
+        std::uint32_t child = NONE;
+    };
+
+    std::vector<polygon<Capacity>> m_children;
+    std::vector<node> m_nodes;
+
+    // All children are updated with a single computation of the compound global transform
+    void on_shape_transform_update(const glm::mat3 &ltransform, const glm::mat3 &gtransform) override
+    {
+        shape2D::on_shape_transform_update(ltransform, gtransform);
+        for (polygon<Capacity> &child : m_children)
+            child.update(gtransform);
+    }
+
+    template <class Pieces> glm::vec2 initialize_children(const Pieces &pieces)
+    {
+        KIT_ASSERT_ERROR(!std::empty(pieces), "Cannot create a compound shape without pieces")
+        m_children.clear();
+        m_children.reserve(std::size(pieces));
+
+        glm::vec2 lcentroid(0.f);
+        m_area = 0.f;
+        for (const auto &piece : pieces)
+        {
+            const polygon<Capacity> &child = m_children.emplace_back(std::begin(piece), std::end(piece));
+            lcentroid += child.area() * child.lposition();
+            m_area += child.area();
+        }
+        lcentroid /= m_area;
+
+        float inertia = 0.f;
+        m_convex = m_children.size() == 1;
+        for (polygon<Capacity> &child : m_children)
+        {
+            const glm::vec2 lposition = child.lposition() - lcentroid;
+            inertia += child.area() * (child.inertia() + glm::length2(lposition));
+
+            child.begin_update();
+            child.lposition(lposition);
+            child.parent(&m_ltransform);
+            child.end_update();
+        }
+        m_inertia = inertia / m_area;
+
+        m_nodes.clear();
+        m_nodes.reserve(2 * m_children.size() - 1);
+        std::vector<std::uint32_t> indices(m_children.size());
+        for (std::uint32_t i = 0; i < indices.size(); i++)
+            indices[i] = i;
+        build_tree(indices.begin(), indices.end());
+        return lcentroid;
+    }
+
+    // Nodes are always pushed after their parent, so the tree can be refitted with a single reverse sweep
+    std::uint32_t build_tree(const std::vector<std::uint32_t>::iterator begin,
+                             const std::vector<std::uint32_t>::iterator end)
+    {
+        const std::uint32_t index = (std::uint32_t)m_nodes.size();
+        m_nodes.emplace_back();
+        if (end - begin == 1)
+        {
+            m_nodes[index].child = *begin;
+            return index;
+        }
+
+        glm::vec2 min(FLT_MAX), max(-FLT_MAX);
+        for (auto it = begin; it != end; ++it)
+        {
+            min = glm::min(min, m_children[*it].lposition());
+            max = glm::max(max, m_children[*it].lposition());
+        }
+        const int axis = (max.x - min.x) >= (max.y - min.y) ? 0 : 1;
+        const auto mid = begin + (end - begin) / 2;
+        std::nth_element(begin, mid, end, [this, axis](const std::uint32_t i1, const std::uint32_t i2) {
+            return m_children[i1].lposition()[axis] < m_children[i2].lposition()[axis];
+        });
+
+        const std::uint32_t left = build_tree(begin, mid);
+        const std::uint32_t right = build_tree(mid, end);
+        m_nodes[index].left = left;
+        m_nodes[index].right = right;
+        return index;
+    }
+
+    void reparent_children()
+    {
+        for (polygon<Capacity> &child : m_children)
+            child.parent(&m_ltransform);
+    }
+};
+
+// Narrow phase of compounds, which only tests the children whose bounding boxes overlap the other shape
+template <std::size_t Capacity> bool intersects(const compound<Capacity> &comp, const shape2D &sh)
+{
+    bool intersect = false;
+    comp.query(sh.bounding_box(), [&sh, &intersect](const polygon<Capacity> &child) {
+        intersect = gjk(child, sh).intersect;
+        return intersect;
+    });
+    return intersect;
+}
+template <std::size_t Capacity> bool intersects(const shape2D &sh, const compound<Capacity> &comp)
+{
+    return intersects(comp, sh);
+}
+template <std::size_t Capacity1, std::size_t Capacity2>
+bool intersects(const compound<Capacity1> &comp1, const compound<Capacity2> &comp2)
+{
+    bool intersect = false;
+    comp1.query(comp2.bounding_box(), [&comp2, &intersect](const polygon<Capacity1> &child) {
+        intersect = intersects(comp2, child);
+        return intersect;
+    });
+    return intersect;
+}
+
+// Deepest penetration among the children, following the rounded_mtv convention. Invalid when no child intersects the
+// other shape
+template <std::size_t Capacity>
+epa_result mtv(const compound<Capacity> &comp, const shape2D &sh, const float threshold = 1.e-3f)
+{
+    epa_result deepest{};
+    comp.query(sh.bounding_box(), [&sh, &deepest, threshold](const polygon<Capacity> &child) {
+        const epa_result result = rounded_mtv(child, sh, threshold);
+        if (result.valid && (!deepest.valid || glm::length2(result.mtv) > glm::length2(deepest.mtv)))
+            deepest = result;
+    });
+    return deepest;
+}
+template <std::size_t Capacity>
+epa_result mtv(const shape2D &sh, const compound<Capacity> &comp, const float threshold = 1.e-3f)
+{
+    epa_result result = mtv(comp, sh, threshold);
+    result.mtv = -result.mtv;
+    std::swap(result.witness1, result.witness2);
+    return result;
+}
+template <std::size_t Capacity1, std::size_t Capacity2>
+epa_result mtv(const compound<Capacity1> &comp1, const compound<Capacity2> &comp2, const float threshold = 1.e-3f)
+{
+    epa_result deepest{};
+    comp1.query(comp2.bounding_box(), [&comp2, &deepest, threshold](const polygon<Capacity1> &child) {
+        const epa_result result = mtv(child, comp2, threshold);
+        if (result.valid && (!deepest.valid || glm::length2(result.mtv) > glm::length2(deepest.mtv)))
+            deepest = result;
+    });
+    return deepest;
+}
+} // namespace geo
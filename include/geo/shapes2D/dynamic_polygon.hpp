@@ -0,0 +1,142 @@
+#pragma once
+
+#include "geo/shapes2D/shape2D.hpp"
+#include <glm/vec2.hpp>
+#include <memory_resource>
+#include <initializer_list>
+#include <iterator>
+#include <span>
+#include <array>
+
+namespace geo
+{
+// Convex polygon whose vertex count is chosen at runtime. Up to INLINE_CAPACITY vertices are stored inside the
+// object, and larger polygons allocate their vertices from a memory resource, which may be an arena shared by many
+// polygons. Unlike polygon<Capacity>, a single class serves every vertex count and only the used vertices take space
+class dynamic_polygon final : public shape2D
+{
+  public:
+    static inline constexpr std::size_t INLINE_CAPACITY = 8;
+
+    class vertex_view
+    {
+      public:
+        const glm::vec2 &operator[](const std::size_t index) const
+        {
+            return m_data[index % m_size];
+        }
+
+        const glm::vec2 *begin() const
+        {
+            return m_data;
+        }
+        const glm::vec2 *end() const
+        {
+            return m_data + m_size;
+        }
+
+        std::size_t size() const
+        {
+            return m_size;
+        }
+
+        std::span<const glm::vec2> span() const
+        {
+            return {m_data, m_size};
+        }
+
+      private:
+        glm::vec2 *m_data = nullptr;
+        std::size_t m_size = 0;
+
+        glm::vec2 &operator()(const std::size_t index)
+        {
+            return m_data[index % m_size];
+        }
+
+        friend class dynamic_polygon;
+    };
+
+    struct vertex_container
+    {
+        vertex_view locals;
+        vertex_view globals;
+        vertex_view edges;
+        vertex_view normals;
+        vertex_view model;
+        std::size_t size() const
+        {
+            return locals.size();
+        }
+    };
+
+    dynamic_polygon(std::span<const glm::vec2> verts = square(1.f),
+                    std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+    dynamic_polygon(std::initializer_list<glm::vec2> verts,
+                    std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+    template <std::forward_iterator It>
+    dynamic_polygon(It it1, It it2, std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+        : m_resource(resource)
+    {
+        allocate((std::size_t)std::distance(it1, it2));
+        std::copy(it1, it2, &vertices.locals(0));
+        m_ltransform.position = initialize_properties_and_vertices();
+        update();
+    }
+
+    dynamic_polygon(const kit::transform2D<float> &ltransform, std::span<const glm::vec2> verts = square(1.f),
+                    std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+    dynamic_polygon(const kit::transform2D<float> &ltransform, std::initializer_list<glm::vec2> verts,
+                    std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+    template <std::forward_iterator It>
+    dynamic_polygon(const kit::transform2D<float> &ltransform, It it1, It it2,
+                    std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+        : shape2D(ltransform), m_resource(resource)
+    {
+        allocate((std::size_t)std::distance(it1, it2));
+        std::copy(it1, it2, &vertices.locals(0));
+        initialize_properties_and_vertices();
+        update();
+    }
+
+    // Copies allocate from the memory resource of the copied polygon
+    dynamic_polygon(const dynamic_polygon &other);
+    dynamic_polygon(dynamic_polygon &&other) noexcept;
+    ~dynamic_polygon();
+
+    dynamic_polygon &operator=(const dynamic_polygon &other);
+    dynamic_polygon &operator=(dynamic_polygon &&other) noexcept;
+
+    vertex_container vertices;
+
+    glm::vec2 support_point(const glm::vec2 &direction) const override;
+    bool contains_point(const glm::vec2 &p) const override;
+    glm::vec2 closest_direction_from(const glm::vec2 &p) const override;
+
+    void bound() override;
+
+    bool spilled() const;
+    std::pmr::memory_resource *resource() const;
+
+    static std::array<glm::vec2, 4> square(float size);
+    static std::array<glm::vec2, 4> rect(float width, float height);
+    static std::vector<glm::vec2> ngon(float radius, std::uint32_t edges);
+
+#ifdef KIT_USE_YAML_CPP
+    YAML::Node encode() const override;
+    bool decode(const YAML::Node &node) override;
+#endif
+
+  private:
+    std::array<glm::vec2, 5 * INLINE_CAPACITY> m_inline;
+    glm::vec2 *m_spill = nullptr;
+    std::pmr::memory_resource *m_resource;
+
+    void allocate(std::size_t size);
+    void release();
+    void copy_vertices(const dynamic_polygon &other);
+
+    void on_shape_transform_update(const glm::mat3 &ltransform, const glm::mat3 &gtransform) override;
+    glm::vec2 initialize_properties_and_vertices();
+};
+} // namespace geo
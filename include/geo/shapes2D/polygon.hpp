@@ -3,10 +3,14 @@
 #include "geo/shapes2D/shape2D.hpp"
 #include "geo/serialization/serialization.hpp"
 #include "geo/shapes2D/vertices2D.hpp"
+#include "geo/shapes2D/polygon_geometry.hpp"
+#include "geo/shapes2D/closest_feature.hpp"
+#include "geo/shapes2D/polygon_descriptor.hpp"
 #include "kit/utility/utils.hpp"
 #include <vector>
 #include <array>
 #include <utility>
+#include <span>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846f
@@ -93,6 +97,34 @@ template <std::size_t Capacity> class polygon final : public shape2D
         update();
     }
 
+    // Skips sorting and mass property computations. Descriptors are meant to be built in a constant expression, such as
+    // static constexpr auto box = make_polygon_descriptor(polygon<8>::rect(2.f, 1.f))
+    template <std::size_t Size>
+        requires(Size >= 3 && Size <= Capacity)
+    polygon(const polygon_descriptor<Size> &desc)
+        : vertices{.locals{desc.model.size()},
+                   .globals{desc.model.size()},
+                   .edges{desc.model.size()},
+                   .normals{desc.model.size()},
+                   .model{desc.model}}
+    {
+        m_ltransform.position = desc.centroid;
+        initialize_properties(desc);
+        update();
+    }
+    template <std::size_t Size>
+        requires(Size >= 3 && Size <= Capacity)
+    polygon(const kit::transform2D<float> &ltransform, const polygon_descriptor<Size> &desc)
+        : shape2D(ltransform), vertices{.locals{desc.model.size()},
+                                        .globals{desc.model.size()},
+                                        .edges{desc.model.size()},
+                                        .normals{desc.model.size()},
+                                        .model{desc.model}}
+    {
+        initialize_properties(desc);
+        update();
+    }
+
     vertex_container vertices;
 
     glm::vec2 support_point(const glm::vec2 &direction) const override
@@ -127,6 +159,8 @@ template <std::size_t Capacity> class polygon final : public shape2D
 
     glm::vec2 closest_direction_from(const glm::vec2 &p) const override
     {
+        if (m_convex && vertices.size() >= closest_feature_search_threshold)
+            return closest_feature_from(vertices, p).direction;
         float min_dist = FLT_MAX;
         glm::vec2 closest(0.f);
         for (std::size_t i = 0; i < vertices.size(); i++)
@@ -160,13 +194,89 @@ template <std::size_t Capacity> class polygon final : public shape2D
         }
     }
 
-    static kit::dynarray<glm::vec2, 4> square(const float size)
+    // Vertices are given in global coordinates and must keep the polygon counter-clockwise and simple. Area, centroid
+    // and inertia are updated from the triangles the edited vertex forms with the centroid, and convexity from the
+    // turns around it. The model is then re-centered on the new centroid, which moves the local position with it
+    void move_vertex(const std::size_t index, const glm::vec2 &gvertex)
+    {
+        KIT_PERF_FUNCTION()
+        KIT_ASSERT_ERROR(index < vertices.size(), "Vertex index out of bounds: {0} for {1} vertices", index,
+                         vertices.size())
+        const std::size_t size = vertices.size();
+        const std::size_t prev = (index + size - 1) % size, next = (index + 1) % size;
+
+        remove_reflex_turns(prev, index, next);
+        mass_moments moments = current_moments();
+        moments -= fan_triangle(vertices.model[prev], vertices.model[index]);
+        moments -= fan_triangle(vertices.model[index], vertices.model[next]);
+
+        vertices.model(index) = to_model(gvertex);
+        moments += fan_triangle(vertices.model[prev], vertices.model[index]);
+        moments += fan_triangle(vertices.model[index], vertices.model[next]);
+        add_reflex_turns(prev, index, next);
+        apply_moments(moments);
+    }
+
+    // The new vertex is placed between the vertices at index - 1 and index, and ends up at index
+    void insert_vertex(const std::size_t index, const glm::vec2 &gvertex)
+    {
+        KIT_PERF_FUNCTION()
+        KIT_ASSERT_ERROR(vertices.size() < Capacity, "Cannot insert a vertex in a full polygon of capacity {0}",
+                         Capacity)
+        KIT_ASSERT_ERROR(index <= vertices.size(), "Vertex index out of bounds: {0} for {1} vertices", index,
+                         vertices.size())
+        const std::size_t old_size = vertices.size();
+        const std::size_t prev = (index + old_size - 1) % old_size, next = index % old_size;
+
+        remove_reflex_turns(prev, next);
+        mass_moments moments = current_moments();
+        moments -= fan_triangle(vertices.model[prev], vertices.model[next]);
+
+        const glm::vec2 model = to_model(gvertex);
+        resize_vertices(old_size + 1);
+        std::move_backward(vertices.model.mbegin() + index, vertices.model.mbegin() + old_size,
+                           vertices.model.mend());
+        vertices.model(index) = model;
+
+        const std::size_t size = old_size + 1;
+        const std::size_t nprev = (index + size - 1) % size, nnext = (index + 1) % size;
+        moments += fan_triangle(vertices.model[nprev], model);
+        moments += fan_triangle(model, vertices.model[nnext]);
+        add_reflex_turns(nprev, index, nnext);
+        apply_moments(moments);
+    }
+
+    void remove_vertex(const std::size_t index)
+    {
+        KIT_PERF_FUNCTION()
+        KIT_ASSERT_ERROR(vertices.size() > 3, "Cannot remove a vertex from a triangle")
+        KIT_ASSERT_ERROR(index < vertices.size(), "Vertex index out of bounds: {0} for {1} vertices", index,
+                         vertices.size())
+        const std::size_t old_size = vertices.size();
+        const std::size_t prev = (index + old_size - 1) % old_size, next = (index + 1) % old_size;
+
+        remove_reflex_turns(prev, index, next);
+        mass_moments moments = current_moments();
+        moments -= fan_triangle(vertices.model[prev], vertices.model[index]);
+        moments -= fan_triangle(vertices.model[index], vertices.model[next]);
+        moments += fan_triangle(vertices.model[prev], vertices.model[next]);
+
+        std::move(vertices.model.mbegin() + index + 1, vertices.model.mend(), vertices.model.mbegin() + index);
+        resize_vertices(old_size - 1);
+
+        const std::size_t size = old_size - 1;
+        const std::size_t nprev = (index + size - 1) % size, nnext = index % size;
+        add_reflex_turns(nprev, nnext);
+        apply_moments(moments);
+    }
+
+    static constexpr kit::dynarray<glm::vec2, 4> square(const float size)
     {
         const float hsize = 0.5f * size;
         return kit::dynarray<glm::vec2, 4>{
             {glm::vec2(-hsize, -hsize), glm::vec2(hsize, -hsize), glm::vec2(hsize, hsize), glm::vec2(-hsize, hsize)}};
     }
-    static kit::dynarray<glm::vec2, 4> rect(const float width, const float height)
+    static constexpr kit::dynarray<glm::vec2, 4> rect(const float width, const float height)
     {
         const float hw = 0.5f * width;
         const float hh = 0.5f * height;
@@ -175,7 +285,7 @@ template <std::size_t Capacity> class polygon final : public shape2D
     }
 
     template <std::size_t MaxEdges = Capacity>
-    static kit::dynarray<glm::vec2, MaxEdges> ngon(const float radius, const std::uint32_t edges)
+    static constexpr kit::dynarray<glm::vec2, MaxEdges> ngon(const float radius, const std::uint32_t edges)
     {
         KIT_ASSERT_ERROR(edges >= 3, "Cannot make polygon with less than 3 edges - edges: {0}", edges)
         KIT_ASSERT_ERROR(edges <= MaxEdges, "Cannot make polygon with more than {0} edges - edges: {1}", MaxEdges,
@@ -185,7 +295,7 @@ template <std::size_t Capacity> class polygon final : public shape2D
         for (std::size_t i = 0; i < edges; i++)
         {
             const float rotation = i * dangle;
-            vertices[i] = {radius * sinf(rotation), radius * cosf(rotation)};
+            vertices[i] = {radius * constexpr_sin(rotation), radius * constexpr_cos(rotation)};
         }
         return vertices;
     }
@@ -221,143 +331,126 @@ template <std::size_t Capacity> class polygon final : public shape2D
         }
     }
 
-    void sort_local_vertices()
-    {
-        const glm::vec2 center = center_of_local_vertices();
-        const glm::vec2 reference = vertices.locals[0] - center;
+    // Convexity is tracked as the amount of clockwise turns so that edits only recheck the turns around them
+    std::size_t m_reflex_turns = 0;
 
-        const auto cmp = [&center, &reference](const glm::vec2 &v1, const glm::vec2 &v2) {
-            const glm::vec2 dir1 = v1 - center, dir2 = v2 - center;
+    // Area, first and polar second moments of area of the triangles fanned from the model origin
+    struct mass_moments
+    {
+        float area;
+        glm::vec2 first;
+        float polar;
 
-            const float det2 = kit::cross2D(reference, dir2);
-            if (kit::approaches_zero(det2) && glm::dot(reference, dir2) >= 0.f)
-                return false;
-            const float det1 = kit::cross2D(reference, dir1);
-            if (kit::approaches_zero(det1) && glm::dot(reference, dir1) >= 0.f)
-                return true;
+        mass_moments &operator+=(const mass_moments &other)
+        {
+            area += other.area;
+            first += other.first;
+            polar += other.polar;
+            return *this;
+        }
+        mass_moments &operator-=(const mass_moments &other)
+        {
+            area -= other.area;
+            first -= other.first;
+            polar -= other.polar;
+            return *this;
+        }
+    };
 
-            if (det1 * det2 >= 0.f)
-                return kit::cross2D(dir1, dir2) > 0.f;
-            return det1 > 0.f;
-        };
-        std::sort(vertices.locals.mbegin(), vertices.locals.mend(), cmp);
+    static mass_moments fan_triangle(const glm::vec2 &p1, const glm::vec2 &p2)
+    {
+        const float crs = kit::cross2D(p1, p2);
+        return {0.5f * crs, crs * (p1 + p2) / 6.f,
+                crs * (glm::dot(p1, p1) + glm::dot(p1, p2) + glm::dot(p2, p2)) / 12.f};
     }
 
-    glm::vec2 initialize_properties_and_vertices()
+    // The model is centered on the centroid, so its first moment is zero
+    mass_moments current_moments() const
     {
-        sort_local_vertices();
-        const glm::vec2 current_lcentroid = compute_center_of_mass();
+        return {m_area, glm::vec2(0.f), m_inertia * m_area};
+    }
 
+    void apply_moments(const mass_moments &moments)
+    {
+        KIT_ASSERT_WARN(moments.area > 0.f, "Vertex edit left the polygon degenerate or clockwise - area: {0}",
+                        moments.area)
+        const glm::vec2 centroid = moments.first / moments.area;
         for (std::size_t i = 0; i < vertices.size(); i++)
-            vertices.model(i) = vertices.locals[i] - current_lcentroid;
+            vertices.model(i) -= centroid;
 
-        m_area = compute_area();
-        m_inertia = compute_inertia();
-        m_convex = compute_convexity();
-        return current_lcentroid;
+        m_area = moments.area;
+        m_inertia = (moments.polar - moments.area * glm::length2(centroid)) / moments.area;
+        m_convex = m_reflex_turns == 0;
+
+        const glm::mat3 ltransform = m_ltransform.center_scale_rotate_translate3(true);
+        m_ltransform.position += glm::vec2(ltransform * glm::vec3(centroid, 0.f));
+        update();
     }
 
-    glm::vec2 center_of_local_vertices()
+    // Undoes the parent global transform first, as global vertices are built with parent * local
+    glm::vec2 to_model(const glm::vec2 &gvertex) const
     {
-        glm::vec2 center(0.f);
-        for (const glm::vec2 &v : vertices.locals)
-            center += v;
-        return center / (float)vertices.locals.size();
+        glm::vec3 lvertex{gvertex, 1.f};
+        if (m_ltransform.parent)
+            lvertex = m_ltransform.parent->inverse_center_scale_rotate_translate3() * lvertex;
+        return m_ltransform.inverse_center_scale_rotate_translate3(true) * lvertex;
     }
 
-    glm::vec2 compute_center_of_mass()
+    void resize_vertices(const std::size_t size)
     {
-        const glm::vec2 &p1 = vertices.locals[0]; // No model available yet
-        glm::vec2 num(0.f), den(0.f);
-        for (std::size_t i = 1; i < vertices.locals.size() - 1; i++)
-        {
-            const glm::vec2 e1 = vertices.locals[i] - p1;
-            const glm::vec2 e2 = vertices.locals[i + 1] - p1;
-
-            const float crs = std::abs(kit::cross2D(e1, e2));
-            num += (e1 + e2) * crs;
-            den += crs;
-        }
-        return p1 + num / (3.f * den);
+        vertices.locals.m_vertices.resize(size);
+        vertices.globals.m_vertices.resize(size);
+        vertices.edges.m_vertices.resize(size);
+        vertices.normals.m_vertices.resize(size);
+        vertices.model.m_vertices.resize(size);
     }
 
-    float compute_area()
+    bool reflex_turn(const std::size_t index) const
     {
-        float area = 0.f;
-        const glm::vec2 &p1 = vertices.model[0];
-
-        for (std::size_t i = 1; i < vertices.size() - 1; i++)
-        {
-            const glm::vec2 e1 = vertices.model[i] - p1;
-            const glm::vec2 e2 = vertices.model[i + 1] - p1;
-            area += std::abs(kit::cross2D(e1, e2));
-        }
-        return area * 0.5f;
+        const std::size_t size = vertices.size();
+        const glm::vec2 &prev = vertices.model[(index + size - 1) % size];
+        const glm::vec2 &current = vertices.model[index];
+        const glm::vec2 &next = vertices.model[(index + 1) % size];
+        return kit::cross2D(current - prev, next - current) < 0.f;
     }
-
-    float compute_inertia()
+    template <class... Indices> void remove_reflex_turns(const Indices... indices)
     {
-        const glm::vec2 &p1 = vertices.model[0];
-        float inertia = 0.f;
-
-        for (std::size_t i = 1; i < vertices.size() - 1; i++)
-        {
-            const glm::vec2 &p2 = vertices.model[i];
-            const glm::vec2 &p3 = vertices.model[i + 1];
-            const glm::vec2 e1 = p1 - p2;
-            const glm::vec2 e2 = p3 - p2;
-
-            const float w = glm::length(e1);
-
-            const float w1 = std::abs(glm::dot(e1, e2) / w);
-            const float w2 = std::abs(w - w1);
-
-            const float h = std::abs(kit::cross2D(e2, e1)) / w;
-            const glm::vec2 p4 = p2 + e1 * w1 / w;
-
-            const float i1 = w1 * h * (w1 * w1 / 3.f + h * h) / 4.f;
-            const float i2 = w2 * h * (w2 * w2 / 3.f + h * h) / 4.f;
-
-            const float m1 = 0.5f * w1 * h;
-            const float m2 = 0.5f * w2 * h;
-
-            const glm::vec2 cm1 = (p2 + p3 + p4) / 3.f;
-            const glm::vec2 cm2 = (p1 + p3 + p4) / 3.f;
-
-            const float icm1 = i1 + m1 * (glm::length2(cm1) - glm::distance2(cm1, p3));
-            const float icm2 = i2 + m2 * (glm::length2(cm2) - glm::distance2(cm2, p3));
-
-            const glm::vec2 p13 = p1 - p3;
-            const glm::vec2 p43 = p4 - p3;
-            const glm::vec2 p23 = -e2;
-
-            if (kit::cross2D(p13, p43) < 0.f)
-                inertia += icm1;
-            else
-                inertia -= icm1;
-            if (kit::cross2D(p43, p23) < 0.f)
-                inertia += icm2;
-            else
-                inertia -= icm2;
-        }
-        return std::abs(inertia) / m_area;
+        ((m_reflex_turns -= reflex_turn(indices)), ...);
     }
-
-    bool compute_convexity() const
+    template <class... Indices> void add_reflex_turns(const Indices... indices)
     {
-        for (std::size_t i = 0; i < vertices.size(); i++) // No edges available yet
-            if (kit::cross2D(vertices.model[i + 1] - vertices.model[i], vertices.model[i + 2] - vertices.model[i + 1]) <
-                0.f)
-                return false;
+        ((m_reflex_turns += reflex_turn(indices)), ...);
+    }
+    std::size_t count_reflex_turns() const
+    {
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < vertices.size(); i++)
+            count += reflex_turn(i);
+        return count;
+    }
 
-        return true;
+    template <std::size_t Size> void initialize_properties(const polygon_descriptor<Size> &desc)
+    {
+        m_area = desc.area;
+        m_inertia = desc.inertia;
+        m_convex = desc.convex;
+        m_reflex_turns = m_convex ? 0 : count_reflex_turns();
     }
 
-    static glm::vec2 towards_segment_from(const glm::vec2 &p1, const glm::vec2 &p2, const glm::vec2 &p)
+    glm::vec2 initialize_properties_and_vertices()
     {
-        const float interp = std::clamp(glm::dot(p - p1, p2 - p1) / glm::distance2(p1, p2), 0.f, 1.f);
-        const glm::vec2 proj = p1 + interp * (p2 - p1);
-        return proj - p;
+        sort_polygon_vertices({&vertices.locals(0), vertices.size()});
+        const glm::vec2 current_lcentroid = polygon_center_of_mass({&vertices.locals[0], vertices.size()});
+
+        for (std::size_t i = 0; i < vertices.size(); i++)
+            vertices.model(i) = vertices.locals[i] - current_lcentroid;
+
+        const std::span<const glm::vec2> model{&vertices.model[0], vertices.size()};
+        m_area = polygon_area(model);
+        m_inertia = polygon_inertia(model, m_area);
+        m_convex = polygon_convexity(model);
+        m_reflex_turns = m_convex ? 0 : count_reflex_turns();
+        return current_lcentroid;
     }
 };
 } // namespace geo
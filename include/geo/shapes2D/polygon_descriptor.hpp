@@ -0,0 +1,122 @@
+#pragma once
+
+#include "kit/container/dynarray.hpp"
+#include <glm/vec2.hpp>
+#include <algorithm>
+#include <type_traits>
+#include <cmath>
+
+namespace geo
+{
+// Trigonometry usable in constant expressions. At runtime it forwards to the standard library
+constexpr double constexpr_sin_series(const double x)
+{
+    constexpr double pi = 3.14159265358979323846;
+    double reduced = x - 2.0 * pi * (double)(long long)(x / (2.0 * pi));
+    if (reduced > pi)
+        reduced -= 2.0 * pi;
+    else if (reduced < -pi)
+        reduced += 2.0 * pi;
+
+    double term = reduced, sum = reduced;
+    for (int i = 1; i < 12; i++)
+    {
+        term *= -reduced * reduced / ((2 * i) * (2 * i + 1));
+        sum += term;
+    }
+    return sum;
+}
+constexpr float constexpr_sin(const float x)
+{
+    if (std::is_constant_evaluated())
+        return (float)constexpr_sin_series(x);
+    return std::sin(x);
+}
+constexpr float constexpr_cos(const float x)
+{
+    if (std::is_constant_evaluated())
+        return (float)constexpr_sin_series(x + 1.57079632679489661923);
+    return std::cos(x);
+}
+
+// Everything a polygon constructor computes from its vertices. When built in a constant expression, polygons created
+// from it skip sorting and the centroid, area and inertia computations
+template <std::size_t Size> struct polygon_descriptor
+{
+    // Sorted counter-clockwise and centered on the center of mass
+    kit::dynarray<glm::vec2, Size> model;
+    glm::vec2 centroid;
+    float area;
+    float inertia;
+    bool convex;
+};
+
+// Equivalent to sort_polygon_vertices, polygon_center_of_mass, polygon_area, polygon_inertia and polygon_convexity
+template <std::size_t Size>
+constexpr polygon_descriptor<Size> make_polygon_descriptor(const kit::dynarray<glm::vec2, Size> &vertices)
+{
+    constexpr auto cross = [](const glm::vec2 &v1, const glm::vec2 &v2) { return v1.x * v2.y - v1.y * v2.x; };
+    constexpr auto dot = [](const glm::vec2 &v1, const glm::vec2 &v2) { return v1.x * v2.x + v1.y * v2.y; };
+    constexpr auto approaches_zero = [](const float x) { return x < 1.e-6f && x > -1.e-6f; };
+    constexpr auto abs = [](const float x) { return x < 0.f ? -x : x; };
+
+    polygon_descriptor<Size> desc{vertices, glm::vec2(0.f), 0.f, 0.f, true};
+    kit::dynarray<glm::vec2, Size> &model = desc.model;
+    const std::size_t size = model.size();
+
+    glm::vec2 center(0.f);
+    for (std::size_t i = 0; i < size; i++)
+        center = glm::vec2(center.x + model[i].x, center.y + model[i].y);
+    center = glm::vec2(center.x / (float)size, center.y / (float)size);
+    const glm::vec2 reference(model[0].x - center.x, model[0].y - center.y);
+
+    std::sort(model.begin(), model.end(), [&](const glm::vec2 &v1, const glm::vec2 &v2) {
+        const glm::vec2 dir1(v1.x - center.x, v1.y - center.y), dir2(v2.x - center.x, v2.y - center.y);
+
+        const float det2 = cross(reference, dir2);
+        if (approaches_zero(det2) && dot(reference, dir2) >= 0.f)
+            return false;
+        const float det1 = cross(reference, dir1);
+        if (approaches_zero(det1) && dot(reference, dir1) >= 0.f)
+            return true;
+
+        if (det1 * det2 >= 0.f)
+            return cross(dir1, dir2) > 0.f;
+        return det1 > 0.f;
+    });
+
+    glm::vec2 num(0.f);
+    float den = 0.f;
+    for (std::size_t i = 1; i < size - 1; i++)
+    {
+        const glm::vec2 e1(model[i].x - model[0].x, model[i].y - model[0].y);
+        const glm::vec2 e2(model[i + 1].x - model[0].x, model[i + 1].y - model[0].y);
+        const float crs = abs(cross(e1, e2));
+        num = glm::vec2(num.x + (e1.x + e2.x) * crs, num.y + (e1.y + e2.y) * crs);
+        den += crs;
+    }
+    desc.centroid = glm::vec2(model[0].x + num.x / (3.f * den), model[0].y + num.y / (3.f * den));
+    for (std::size_t i = 0; i < size; i++)
+        model[i] = glm::vec2(model[i].x - desc.centroid.x, model[i].y - desc.centroid.y);
+
+    // Polar moment of each triangle fanned from the centroid
+    float polar = 0.f;
+    for (std::size_t i = 0; i < size; i++)
+    {
+        const glm::vec2 &p1 = model[i], &p2 = model[(i + 1) % size];
+        const float crs = cross(p1, p2);
+        desc.area += 0.5f * crs;
+        polar += crs * (dot(p1, p1) + dot(p1, p2) + dot(p2, p2)) / 12.f;
+    }
+    desc.area = abs(desc.area);
+    desc.inertia = abs(polar) / desc.area;
+
+    for (std::size_t i = 0; i < size; i++)
+    {
+        const glm::vec2 &p1 = model[i], &p2 = model[(i + 1) % size], &p3 = model[(i + 2) % size];
+        if (cross(glm::vec2(p2.x - p1.x, p2.y - p1.y), glm::vec2(p3.x - p2.x, p3.y - p2.y)) < 0.f)
+            desc.convex = false;
+    }
+    return desc;
+}
+} // namespace geo
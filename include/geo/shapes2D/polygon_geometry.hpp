@@ -0,0 +1,40 @@
+#pragma once
+
+#include <glm/vec2.hpp>
+#include <span>
+#include <cmath>
+
+namespace geo
+{
+// Capacity-independent maths shared by all polygon implementations. Vertices are treated as a closed loop
+
+// Sorts the vertices counter-clockwise around their average
+void sort_polygon_vertices(std::span<glm::vec2> vertices);
+
+glm::vec2 polygon_center_of_mass(std::span<const glm::vec2> vertices);
+float polygon_area(std::span<const glm::vec2> vertices);
+
+// Polar moment of inertia per unit area around the origin, which is expected to be the center of mass
+float polygon_inertia(std::span<const glm::vec2> vertices, float area);
+bool polygon_convexity(std::span<const glm::vec2> vertices);
+
+struct rounded_polygon_properties
+{
+    float area;
+    glm::vec2 centroid;
+    float inertia;
+};
+
+// Mass properties of a convex, counter-clockwise polygon swept by a disk of the given radius. The inertia is the polar
+// moment per unit area around the returned centroid
+rounded_polygon_properties rounded_polygon_mass_properties(std::span<const glm::vec2> vertices, float radius);
+
+glm::vec2 towards_segment_from(const glm::vec2 &p1, const glm::vec2 &p2, const glm::vec2 &p);
+
+// Monotonic in the angle of the direction in [0, 2pi), without calling atan2
+inline float pseudo_angle(const glm::vec2 &direction)
+{
+    const float p = direction.x / (std::abs(direction.x) + std::abs(direction.y));
+    return direction.y < 0.f ? 3.f + p : 1.f - p;
+}
+} // namespace geo
@@ -0,0 +1,221 @@
+#pragma once
+
+#include "geo/shapes2D/polygon.hpp"
+#include "geo/shapes2D/polygon_geometry.hpp"
+#include <span>
+
+namespace geo
+{
+// Convex polygon swept by a disk of the given radius. The vertices describe the core polygon, so that support points
+// and closest features only touch as many vertices as the core has, instead of the many needed to approximate the
+// rounded corners. The core is not exposed as vertices because polygon algorithms such as sat or clipping_contacts
+// would silently ignore the radius
+template <std::size_t Capacity> class rounded_polygon final : public shape2D
+{
+  public:
+    using vertex_container = typename polygon<Capacity>::vertex_container;
+
+    template <std::size_t Size = 4>
+        requires(Size >= 3 && Size <= Capacity)
+    rounded_polygon(const kit::dynarray<glm::vec2, Size> &verts = polygon<Capacity>::square(1.f),
+                    const float radius = 0.1f)
+        : core{.locals{verts},
+               .globals{verts.size()},
+               .edges{verts.size()},
+               .normals{verts.size()},
+               .model{verts.size()}},
+          m_radius(radius)
+    {
+        m_ltransform.position = initialize_properties_and_vertices();
+        update();
+    }
+    rounded_polygon(std::initializer_list<glm::vec2> verts, const float radius)
+        : core{.locals{verts},
+               .globals{verts.size()},
+               .edges{verts.size()},
+               .normals{verts.size()},
+               .model{verts.size()}},
+          m_radius(radius)
+    {
+        m_ltransform.position = initialize_properties_and_vertices();
+        update();
+    }
+
+    template <std::size_t Size>
+        requires(Size >= 3 && Size <= Capacity)
+    rounded_polygon(const kit::transform2D<float> &ltransform, const kit::dynarray<glm::vec2, Size> &verts,
+                    const float radius)
+        : shape2D(ltransform), core{.locals{verts},
+                                    .globals{verts.size()},
+                                    .edges{verts.size()},
+                                    .normals{verts.size()},
+                                    .model{verts.size()}},
+          m_radius(radius)
+    {
+        initialize_properties_and_vertices();
+        update();
+    }
+    rounded_polygon(const kit::transform2D<float> &ltransform, std::initializer_list<glm::vec2> verts,
+                    const float radius)
+        : shape2D(ltransform), core{.locals{verts},
+                                    .globals{verts.size()},
+                                    .edges{verts.size()},
+                                    .normals{verts.size()},
+                                    .model{verts.size()}},
+          m_radius(radius)
+    {
+        initialize_properties_and_vertices();
+        update();
+    }
+
+    vertex_container core;
+
+    float radius() const
+    {
+        return m_radius;
+    }
+
+    glm::vec2 support_point(const glm::vec2 &direction) const override
+    {
+        return core_support_point(direction) + glm::normalize(direction) * m_radius;
+    }
+    glm::vec2 core_support_point(const glm::vec2 &direction) const override
+    {
+        std::size_t support = 0;
+        float max_dot = glm::dot(direction, core.globals[support] - m_gcentroid);
+        for (std::size_t i = 1; i < core.size(); i++)
+        {
+            const float dot = glm::dot(direction, core.globals[i] - m_gcentroid);
+            if (dot > max_dot)
+            {
+                max_dot = dot;
+                support = i;
+            }
+        }
+        return core.globals[support];
+    }
+    float core_radius() const override
+    {
+        return m_radius;
+    }
+
+    bool contains_point(const glm::vec2 &p) const override
+    {
+        return core_contains_point(p) || glm::length2(core_closest_direction_from(p)) < m_radius * m_radius;
+    }
+
+    glm::vec2 closest_direction_from(const glm::vec2 &p) const override
+    {
+        const glm::vec2 towards = core_closest_direction_from(p);
+        const float dist2 = glm::length2(towards);
+        if (dist2 == 0.f)
+            return core_closest_normal(p) * m_radius;
+        const glm::vec2 offset = towards * (m_radius / std::sqrt(dist2));
+        return core_contains_point(p) ? towards + offset : towards - offset;
+    }
+
+    void bound() override
+    {
+        m_aabb.min = glm::vec2(FLT_MAX);
+        m_aabb.max = -glm::vec2(FLT_MAX);
+        for (std::size_t i = 0; i < core.size(); i++)
+        {
+            m_aabb.min = glm::min(m_aabb.min, core.globals[i]);
+            m_aabb.max = glm::max(m_aabb.max, core.globals[i]);
+        }
+        m_aabb.min -= m_radius;
+        m_aabb.max += m_radius;
+    }
+
+#ifdef KIT_USE_YAML_CPP
+    YAML::Node encode() const override
+    {
+        return kit::yaml::codec<rounded_polygon>::encode(*this);
+    }
+    bool decode(const YAML::Node &node) override
+    {
+        return kit::yaml::codec<rounded_polygon>::decode(node, *this);
+    }
+#endif
+
+  private:
+    float m_radius;
+
+    bool core_contains_point(const glm::vec2 &p) const
+    {
+        for (std::size_t i = 0; i < core.size(); i++)
+            if (glm::dot(core.normals[i], p - core.globals[i]) > 0.f)
+                return false;
+        return true;
+    }
+
+    // Normal of the core edge whose line is closest to p, for points on the core boundary
+    glm::vec2 core_closest_normal(const glm::vec2 &p) const
+    {
+        float min_dist = FLT_MAX;
+        std::size_t closest = 0;
+        for (std::size_t i = 0; i < core.size(); i++)
+        {
+            const float dist = std::abs(glm::dot(core.normals[i], p - core.globals[i]));
+            if (min_dist > dist)
+            {
+                min_dist = dist;
+                closest = i;
+            }
+        }
+        return core.normals[closest];
+    }
+
+    glm::vec2 core_closest_direction_from(const glm::vec2 &p) const
+    {
+        if (core.size() >= closest_feature_search_threshold)
+            return closest_feature_from(core, p).direction;
+        float min_dist = FLT_MAX;
+        glm::vec2 closest(0.f);
+        for (std::size_t i = 0; i < core.size(); i++)
+        {
+            const glm::vec2 towards = towards_segment_from(core.globals[i], core.globals[i + 1], p);
+            const float dist = glm::length2(towards);
+            if (min_dist > dist)
+            {
+                min_dist = dist;
+                closest = towards;
+            }
+        }
+        return closest;
+    }
+
+    void on_shape_transform_update(const glm::mat3 &ltransform, const glm::mat3 &gtransform) override
+    {
+        shape2D::on_shape_transform_update(ltransform, gtransform);
+        for (std::size_t i = 0; i < core.size(); i++)
+        {
+            core.locals(i) = ltransform * glm::vec3(core.model[i], 1.f);
+            core.globals(i) = gtransform * glm::vec3(core.model[i], 1.f);
+        }
+        for (std::size_t i = 0; i < core.size(); i++)
+        {
+            core.edges(i) = core.globals[i + 1] - core.globals[i];
+            core.normals(i) = glm::normalize(glm::vec2(core.edges[i].y, -core.edges[i].x));
+        }
+    }
+
+    // The radius moves the center of mass of non symmetric cores, so the model is centered on the rounded shape
+    glm::vec2 initialize_properties_and_vertices()
+    {
+        KIT_ASSERT_WARN(m_radius >= 0.f, "Creating rounded polygon with negative radius: {0}", m_radius)
+        sort_polygon_vertices({&core.locals(0), core.size()});
+        const std::span<const glm::vec2> locals{&core.locals[0], core.size()};
+        const rounded_polygon_properties props = rounded_polygon_mass_properties(locals, m_radius);
+
+        for (std::size_t i = 0; i < core.size(); i++)
+            core.model(i) = core.locals[i] - props.centroid;
+
+        m_area = props.area;
+        m_inertia = props.inertia;
+        m_convex = polygon_convexity({&core.model[0], core.size()});
+        KIT_ASSERT_WARN(m_convex, "The core of a rounded polygon must be convex")
+        return props.centroid;
+    }
+};
+} // namespace geo
@@ -3,12 +3,14 @@
 #include <glm/vec2.hpp>
 #include <glm/mat2x2.hpp>
 #include "geo/shapes2D/aabb2D.hpp"
+#include <cstdint>
 
 #include "kit/utility/transform.hpp"
 #include "kit/serialization/yaml/serializer.hpp"
 
 namespace geo
 {
+class transform_hierarchy;
 class shape2D : public kit::yaml::serializable, public kit::yaml::deserializable
 {
   public:
@@ -22,6 +24,7 @@ class shape2D : public kit::yaml::serializable, public kit::yaml::deserializable
 
     void begin_update();
     void end_update();
+    void end_update(const glm::mat3 &parent_gtransform);
 
     const kit::transform2D<float> *parent() const;
     void parent(const kit::transform2D<float> *parent);
@@ -31,6 +34,11 @@ class shape2D : public kit::yaml::serializable, public kit::yaml::deserializable
 
     virtual glm::vec2 closest_direction_from(const glm::vec2 &p) const = 0;
 
+    // Rounded shapes are a core shape swept by a disk of radius core_radius(), so that their support point is the
+    // core support point pushed by the radius. Algorithms may run on the core alone and add the radius analytically
+    virtual glm::vec2 core_support_point(const glm::vec2 &direction) const;
+    virtual float core_radius() const;
+
     const kit::transform2D<float> &ltransform() const;
     void ltransform(const kit::transform2D<float> &ltransform);
 
@@ -60,6 +68,7 @@ class shape2D : public kit::yaml::serializable, public kit::yaml::deserializable
 
     bool updating() const;
     void update();
+    void update(const glm::mat3 &parent_gtransform);
 
   protected:
     kit::transform2D<float> m_ltransform;
@@ -75,6 +84,26 @@ class shape2D : public kit::yaml::serializable, public kit::yaml::deserializable
 
   private:
     bool m_pushing_update = false;
+
+    // Set while attached to a hierarchy node, whose cached global matrix then replaces the parent one in update().
+    // Copies start detached, as the hierarchy only tracks the attached shape
+    struct hierarchy_link
+    {
+        const transform_hierarchy *hierarchy = nullptr;
+        std::uint32_t node = 0;
+
+        hierarchy_link() = default;
+        hierarchy_link(const hierarchy_link &)
+        {
+        }
+        hierarchy_link &operator=(const hierarchy_link &)
+        {
+            return *this;
+        }
+    };
+    hierarchy_link m_hierarchy;
+
+    friend class transform_hierarchy;
 };
 
 } // namespace geo
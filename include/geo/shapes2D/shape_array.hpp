@@ -0,0 +1,155 @@
+#pragma once
+
+#include "geo/shapes2D/shape2D.hpp"
+#include "geo/internal/parallel.hpp"
+#include <memory>
+#include <span>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace geo
+{
+// Fixed-size contiguous storage for shapes of a single concrete type, built once with every shape constructed in
+// place, possibly from several threads. Unlike shape_pool, shapes never move once built, so they may be used as parents
+// of other shapes, and shape types without a default constructor are supported
+template <class Shape>
+    requires std::is_base_of_v<shape2D, Shape>
+class shape_array
+{
+  public:
+    shape_array() = default;
+    ~shape_array()
+    {
+        clear();
+    }
+
+    shape_array(shape_array &&other) noexcept
+        : m_shapes(std::exchange(other.m_shapes, nullptr)), m_size(std::exchange(other.m_size, 0))
+    {
+    }
+    shape_array &operator=(shape_array &&other) noexcept
+    {
+        if (this != &other)
+        {
+            clear();
+            m_shapes = std::exchange(other.m_shapes, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+        }
+        return *this;
+    }
+    shape_array(const shape_array &) = delete;
+    shape_array &operator=(const shape_array &) = delete;
+
+    // Replaces the contents with size shapes. construct(i, storage) must construct shape i at storage, for instance
+    // with std::construct_at, and is called from several threads, in chunks of consecutive indices. If construct throws,
+    // the shapes constructed so far are destroyed and the exception is rethrown, leaving the array empty
+    template <class F>
+    void build(const std::size_t size, F &&construct, const std::uint32_t threads = 0, const std::uint32_t chunk = 64)
+    {
+        KIT_ASSERT_ERROR(chunk > 0, "Chunk size must be greater than 0")
+        clear();
+        if (size == 0)
+            return;
+        m_shapes = std::allocator<Shape>{}.allocate(size);
+
+        const std::uint32_t chunks = (std::uint32_t)((size + chunk - 1) / chunk);
+        const auto chunk_end = [size, chunk](const std::uint32_t index) {
+            return std::min(size, (std::size_t)(index + 1) * chunk);
+        };
+
+        // Each chunk is either fully constructed or unwound by the thread that failed it. Flags are only written by the
+        // thread owning the chunk, and read once every thread stopped
+        std::vector<std::uint8_t> built(chunks, 0);
+        try
+        {
+            parallel_for(chunks, threads, [this, chunk, &construct, &chunk_end, &built](const std::uint32_t index) {
+                const std::size_t begin = (std::size_t)index * chunk, end = chunk_end(index);
+                std::size_t i = begin;
+                try
+                {
+                    for (; i < end; i++)
+                        construct(i, m_shapes + i);
+                }
+                catch (...)
+                {
+                    std::destroy(m_shapes + begin, m_shapes + i);
+                    throw;
+                }
+                built[index] = 1;
+            });
+        }
+        catch (...)
+        {
+            for (std::uint32_t index = 0; index < chunks; index++)
+                if (built[index])
+                    std::destroy(m_shapes + (std::size_t)index * chunk, m_shapes + chunk_end(index));
+            std::allocator<Shape>{}.deallocate(m_shapes, size);
+            m_shapes = nullptr;
+            throw;
+        }
+        m_size = size;
+    }
+
+    void clear()
+    {
+        if (!m_shapes)
+            return;
+        std::destroy_n(m_shapes, m_size);
+        std::allocator<Shape>{}.deallocate(m_shapes, m_size);
+        m_shapes = nullptr;
+        m_size = 0;
+    }
+
+    Shape &operator[](const std::size_t index)
+    {
+        KIT_ASSERT_ERROR(index < m_size, "Shape index out of bounds: {0} for {1} shapes", index, m_size)
+        return m_shapes[index];
+    }
+    const Shape &operator[](const std::size_t index) const
+    {
+        KIT_ASSERT_ERROR(index < m_size, "Shape index out of bounds: {0} for {1} shapes", index, m_size)
+        return m_shapes[index];
+    }
+
+    std::span<Shape> shapes()
+    {
+        return {m_shapes, m_size};
+    }
+    std::span<const Shape> shapes() const
+    {
+        return {m_shapes, m_size};
+    }
+
+    Shape *begin()
+    {
+        return m_shapes;
+    }
+    Shape *end()
+    {
+        return m_shapes + m_size;
+    }
+    const Shape *begin() const
+    {
+        return m_shapes;
+    }
+    const Shape *end() const
+    {
+        return m_shapes + m_size;
+    }
+
+    std::size_t size() const
+    {
+        return m_size;
+    }
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+  private:
+    Shape *m_shapes = nullptr;
+    std::size_t m_size = 0;
+};
+} // namespace geo
@@ -0,0 +1,265 @@
+#pragma once
+
+#include "geo/shapes2D/shape2D.hpp"
+#include <vector>
+#include <tuple>
+#include <span>
+#include <cstdint>
+#include <compare>
+#include <functional>
+#include <type_traits>
+
+namespace geo
+{
+template <class Shape> struct shape_handle
+{
+    static inline constexpr std::uint32_t INVALID = UINT32_MAX;
+
+    std::uint32_t index = INVALID;
+    std::uint32_t generation = 0;
+
+    explicit operator bool() const
+    {
+        return index != INVALID;
+    }
+    auto operator<=>(const shape_handle &other) const = default;
+};
+
+// Stores shapes of a single concrete type contiguously, so that per-shape loops run over dense memory. Shapes are
+// accessed through generation-checked handles, which stay valid until their shape is destroyed.
+// Creating or destroying shapes may move other shapes of the same pool, invalidating pointers and references to
+// them. For that reason, shapes stored in a pool should not be used as parents of other shapes
+template <class Shape>
+    requires std::is_base_of_v<shape2D, Shape>
+class shape_pool
+{
+  public:
+    using handle = shape_handle<Shape>;
+
+    template <class... ShapeArgs> handle create(ShapeArgs &&...args)
+    {
+        std::uint32_t index;
+        if (m_free != NONE)
+        {
+            index = m_free;
+            m_free = m_slots[index].dense;
+        }
+        else
+        {
+            index = (std::uint32_t)m_slots.size();
+            m_slots.emplace_back();
+        }
+        m_slots[index].dense = (std::uint32_t)m_shapes.size();
+        m_shapes.emplace_back(std::forward<ShapeArgs>(args)...);
+        m_owners.push_back(index);
+        return {index, m_slots[index].generation};
+    }
+
+    bool destroy(const handle hdl)
+    {
+        if (!valid(hdl))
+            return false;
+        slot &sl = m_slots[hdl.index];
+        const std::uint32_t last = (std::uint32_t)m_shapes.size() - 1;
+        if (sl.dense != last)
+        {
+            m_shapes[sl.dense] = std::move(m_shapes[last]);
+            m_owners[sl.dense] = m_owners[last];
+            m_slots[m_owners[sl.dense]].dense = sl.dense;
+        }
+        m_shapes.pop_back();
+        m_owners.pop_back();
+
+        sl.generation++;
+        sl.dense = m_free;
+        m_free = hdl.index;
+        return true;
+    }
+
+    bool valid(const handle hdl) const
+    {
+        return hdl.index < m_slots.size() && m_slots[hdl.index].generation == hdl.generation &&
+               m_slots[hdl.index].dense < m_shapes.size() && m_owners[m_slots[hdl.index].dense] == hdl.index;
+    }
+
+    Shape *get(const handle hdl)
+    {
+        return valid(hdl) ? &m_shapes[m_slots[hdl.index].dense] : nullptr;
+    }
+    const Shape *get(const handle hdl) const
+    {
+        return valid(hdl) ? &m_shapes[m_slots[hdl.index].dense] : nullptr;
+    }
+
+    Shape &operator[](const handle hdl)
+    {
+        KIT_ASSERT_ERROR(valid(hdl), "Invalid shape handle - index: {0}, generation: {1}", hdl.index, hdl.generation)
+        return m_shapes[m_slots[hdl.index].dense];
+    }
+    const Shape &operator[](const handle hdl) const
+    {
+        KIT_ASSERT_ERROR(valid(hdl), "Invalid shape handle - index: {0}, generation: {1}", hdl.index, hdl.generation)
+        return m_shapes[m_slots[hdl.index].dense];
+    }
+
+    // Handle of the shape currently stored at the given dense position
+    handle handle_of(const std::size_t dense_index) const
+    {
+        const std::uint32_t index = m_owners[dense_index];
+        return {index, m_slots[index].generation};
+    }
+
+    std::span<Shape> shapes()
+    {
+        return m_shapes;
+    }
+    std::span<const Shape> shapes() const
+    {
+        return m_shapes;
+    }
+
+    auto begin()
+    {
+        return m_shapes.begin();
+    }
+    auto end()
+    {
+        return m_shapes.end();
+    }
+    auto begin() const
+    {
+        return m_shapes.begin();
+    }
+    auto end() const
+    {
+        return m_shapes.end();
+    }
+
+    std::size_t size() const
+    {
+        return m_shapes.size();
+    }
+    bool empty() const
+    {
+        return m_shapes.empty();
+    }
+
+    void reserve(const std::size_t capacity)
+    {
+        m_shapes.reserve(capacity);
+        m_owners.reserve(capacity);
+        m_slots.reserve(capacity);
+    }
+
+    // Destroys every shape. Outstanding handles become invalid
+    void clear()
+    {
+        for (std::uint32_t i = 0; i < m_owners.size(); i++)
+        {
+            slot &sl = m_slots[m_owners[i]];
+            sl.generation++;
+            sl.dense = m_free;
+            m_free = m_owners[i];
+        }
+        m_shapes.clear();
+        m_owners.clear();
+    }
+
+  private:
+    static inline constexpr std::uint32_t NONE = UINT32_MAX;
+    struct slot
+    {
+        // Dense index of the shape while alive, next free slot otherwise
+        std::uint32_t dense = NONE;
+        std::uint32_t generation = 0;
+    };
+
+    std::vector<Shape> m_shapes;
+    std::vector<std::uint32_t> m_owners;
+    std::vector<slot> m_slots;
+    std::uint32_t m_free = NONE;
+};
+
+// One shape_pool per concrete shape type
+template <class... Shapes> class shape_store
+{
+  public:
+    template <class Shape> using handle = shape_handle<Shape>;
+
+    template <class Shape, class... ShapeArgs> handle<Shape> create(ShapeArgs &&...args)
+    {
+        return pool<Shape>().create(std::forward<ShapeArgs>(args)...);
+    }
+    template <class Shape> bool destroy(const handle<Shape> hdl)
+    {
+        return pool<Shape>().destroy(hdl);
+    }
+    template <class Shape> bool valid(const handle<Shape> hdl) const
+    {
+        return pool<Shape>().valid(hdl);
+    }
+
+    template <class Shape> Shape *get(const handle<Shape> hdl)
+    {
+        return pool<Shape>().get(hdl);
+    }
+    template <class Shape> const Shape *get(const handle<Shape> hdl) const
+    {
+        return pool<Shape>().get(hdl);
+    }
+
+    template <class Shape> Shape &operator[](const handle<Shape> hdl)
+    {
+        return pool<Shape>()[hdl];
+    }
+    template <class Shape> const Shape &operator[](const handle<Shape> hdl) const
+    {
+        return pool<Shape>()[hdl];
+    }
+
+    template <class Shape> shape_pool<Shape> &pool()
+    {
+        return std::get<shape_pool<Shape>>(m_pools);
+    }
+    template <class Shape> const shape_pool<Shape> &pool() const
+    {
+        return std::get<shape_pool<Shape>>(m_pools);
+    }
+
+    // Calls fun with every shape, one pool after the other, with its concrete type
+    template <class F> void for_each(F &&fun)
+    {
+        std::apply([&fun](auto &...pools) { (for_each_in(pools, fun), ...); }, m_pools);
+    }
+    template <class F> void for_each(F &&fun) const
+    {
+        std::apply([&fun](const auto &...pools) { (for_each_in(pools, fun), ...); }, m_pools);
+    }
+
+    std::size_t size() const
+    {
+        return (pool<Shapes>().size() + ... + 0);
+    }
+    void clear()
+    {
+        (pool<Shapes>().clear(), ...);
+    }
+
+  private:
+    std::tuple<shape_pool<Shapes>...> m_pools;
+
+    template <class Pool, class F> static void for_each_in(Pool &pl, F &fun)
+    {
+        for (auto &shape : pl)
+            fun(shape);
+    }
+};
+} // namespace geo
+
+template <class Shape> struct std::hash<geo::shape_handle<Shape>>
+{
+    std::size_t operator()(const geo::shape_handle<Shape> &hdl) const
+    {
+        return std::hash<std::uint64_t>{}(((std::uint64_t)hdl.generation << 32) | hdl.index);
+    }
+};
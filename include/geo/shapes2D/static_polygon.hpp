@@ -0,0 +1,272 @@
+#pragma once
+
+#include "geo/shapes2D/shape2D.hpp"
+#include "geo/shapes2D/polygon.hpp"
+#include "geo/shapes2D/polygon_geometry.hpp"
+#include "geo/serialization/serialization.hpp"
+#include <glm/mat3x3.hpp>
+#include <array>
+#include <cstdint>
+
+namespace geo
+{
+// Compact copy of a polygon meant for static geometry. Model vertices are stored as 16 bit coordinates quantized
+// relative to the bounding box of the model, and normals as 16 bit angles, so that a vertex takes 6 bytes instead of
+// the 40 a polygon spends on its model, local, global, edge and normal vectors. Everything is decoded on the fly: the
+// vertices view yields global vertices and normals by value, which keeps static polygons usable by sat and
+// clipping_contacts. Transform updates are supported but each query pays for one matrix product per decoded vertex
+template <std::size_t Capacity> class static_polygon final : public shape2D
+{
+  public:
+    struct packed_vertex
+    {
+        std::uint16_t x;
+        std::uint16_t y;
+        std::uint16_t normal;
+    };
+
+    class global_view
+    {
+      public:
+        glm::vec2 operator[](const std::size_t index) const
+        {
+            return m_poly->m_gtransform * glm::vec3(m_poly->decode_model(index % m_poly->m_size), 1.f);
+        }
+        std::size_t size() const
+        {
+            return m_poly->m_size;
+        }
+
+      private:
+        const static_polygon *m_poly;
+        global_view(const static_polygon *poly) : m_poly(poly)
+        {
+        }
+        friend class static_polygon;
+    };
+
+    class normal_view
+    {
+      public:
+        glm::vec2 operator[](const std::size_t index) const
+        {
+            return m_poly->decode_global_normal(index % m_poly->m_size);
+        }
+        std::size_t size() const
+        {
+            return m_poly->m_size;
+        }
+
+      private:
+        const static_polygon *m_poly;
+        normal_view(const static_polygon *poly) : m_poly(poly)
+        {
+        }
+        friend class static_polygon;
+    };
+
+    struct vertex_container
+    {
+        global_view globals;
+        normal_view normals;
+        std::size_t size() const
+        {
+            return globals.size();
+        }
+    };
+
+    // Works with any polygon exposing its model vertices, such as polygon<Capacity> or dynamic_polygon
+    template <class Source>
+        requires requires(const Source &poly) {
+            { poly.vertices.model[0] } -> std::convertible_to<glm::vec2>;
+        }
+    explicit static_polygon(const Source &poly)
+        : shape2D(poly.ltransform()), vertices{global_view(this), normal_view(this)},
+          m_size((std::uint32_t)poly.vertices.size())
+    {
+        KIT_ASSERT_ERROR(poly.vertices.size() <= Capacity,
+                         "Static polygon capacity is too small: {0} vertices for a capacity of {1}",
+                         poly.vertices.size(), Capacity)
+        m_area = poly.area();
+        m_inertia = poly.inertia();
+        m_convex = poly.convex();
+        quantize(poly.vertices.model);
+        update();
+    }
+
+    static_polygon(const static_polygon &other)
+        : shape2D(other), vertices{global_view(this), normal_view(this)}, m_packed(other.m_packed),
+          m_model_min(other.m_model_min), m_model_step(other.m_model_step), m_gtransform(other.m_gtransform),
+          m_size(other.m_size)
+    {
+    }
+    static_polygon &operator=(const static_polygon &other)
+    {
+        shape2D::operator=(other);
+        m_packed = other.m_packed;
+        m_model_min = other.m_model_min;
+        m_model_step = other.m_model_step;
+        m_gtransform = other.m_gtransform;
+        m_size = other.m_size;
+        return *this;
+    }
+
+    vertex_container vertices;
+
+    // Maximizes the direction in model space, where the coordinates can be compared without being decoded
+    glm::vec2 support_point(const glm::vec2 &direction) const override
+    {
+        const glm::vec2 mdir = glm::vec2(glm::dot(direction, glm::vec2(m_gtransform[0])),
+                                         glm::dot(direction, glm::vec2(m_gtransform[1]))) *
+                               m_model_step;
+        std::size_t support = 0;
+        float max_dot = mdir.x * m_packed[0].x + mdir.y * m_packed[0].y;
+        for (std::size_t i = 1; i < m_size; i++)
+        {
+            const float dot = mdir.x * m_packed[i].x + mdir.y * m_packed[i].y;
+            if (dot > max_dot)
+            {
+                max_dot = dot;
+                support = i;
+            }
+        }
+        return vertices.globals[support];
+    }
+
+    // The point is moved to model space instead, where containment is tested against the decoded edges
+    bool contains_point(const glm::vec2 &p) const override
+    {
+        KIT_ASSERT_WARN(m_convex,
+                        "Checking if a point is contained in a non convex polygon yields undefined behaviour.")
+        const glm::vec2 mp = to_model(p);
+        glm::vec2 current = decode_model(0);
+        for (std::size_t i = 0; i < m_size; i++)
+        {
+            const glm::vec2 next = decode_model((i + 1) % m_size);
+            if (kit::cross2D(next - current, mp - current) < 0.f)
+                return false;
+            current = next;
+        }
+        return true;
+    }
+
+    glm::vec2 closest_direction_from(const glm::vec2 &p) const override
+    {
+        if (m_convex && m_size >= closest_feature_search_threshold)
+            return closest_feature_from(vertices, p).direction;
+        float min_dist = FLT_MAX;
+        glm::vec2 closest(0.f);
+        glm::vec2 current = vertices.globals[0];
+        for (std::size_t i = 0; i < m_size; i++)
+        {
+            const glm::vec2 next = vertices.globals[i + 1];
+            const glm::vec2 towards = towards_segment_from(current, next, p);
+            const float dist = glm::length2(towards);
+            if (min_dist > dist)
+            {
+                min_dist = dist;
+                closest = towards;
+            }
+            current = next;
+        }
+        return closest;
+    }
+
+    void bound() override
+    {
+        m_aabb.min = glm::vec2(FLT_MAX);
+        m_aabb.max = -glm::vec2(FLT_MAX);
+        for (std::size_t i = 0; i < m_size; i++)
+        {
+            const glm::vec2 v = vertices.globals[i];
+            m_aabb.min = glm::min(m_aabb.min, v);
+            m_aabb.max = glm::max(m_aabb.max, v);
+        }
+    }
+
+    glm::vec2 decode_model(const std::size_t index) const
+    {
+        return m_model_min + glm::vec2(m_packed[index].x, m_packed[index].y) * m_model_step;
+    }
+    glm::vec2 decode_model_normal(const std::size_t index) const
+    {
+        const float angle = m_packed[index].normal * (2.f * (float)M_PI / 65536.f);
+        return glm::vec2(std::cos(angle), std::sin(angle));
+    }
+
+    const std::array<packed_vertex, Capacity> &packed() const
+    {
+        return m_packed;
+    }
+    // Largest distance between a model vertex and its quantized value
+    glm::vec2 precision() const
+    {
+        return 0.5f * m_model_step;
+    }
+
+#ifdef KIT_USE_YAML_CPP
+    YAML::Node encode() const override
+    {
+        return kit::yaml::codec<static_polygon>::encode(*this);
+    }
+    bool decode(const YAML::Node &node) override
+    {
+        return kit::yaml::codec<static_polygon>::decode(node, *this);
+    }
+#endif
+
+  private:
+    std::array<packed_vertex, Capacity> m_packed{};
+    glm::vec2 m_model_min;
+    glm::vec2 m_model_step;
+    glm::mat3 m_gtransform;
+    std::uint32_t m_size;
+
+    template <class Model> void quantize(const Model &model)
+    {
+        m_model_min = glm::vec2(FLT_MAX);
+        glm::vec2 model_max = -glm::vec2(FLT_MAX);
+        for (std::size_t i = 0; i < m_size; i++)
+        {
+            m_model_min = glm::min(m_model_min, glm::vec2(model[i]));
+            model_max = glm::max(model_max, glm::vec2(model[i]));
+        }
+        m_model_step = (model_max - m_model_min) / 65535.f;
+        const glm::vec2 inv_step = glm::vec2(m_model_step.x > 0.f ? 1.f / m_model_step.x : 0.f,
+                                             m_model_step.y > 0.f ? 1.f / m_model_step.y : 0.f);
+
+        for (std::size_t i = 0; i < m_size; i++)
+        {
+            const glm::vec2 q = (glm::vec2(model[i]) - m_model_min) * inv_step;
+            const glm::vec2 edge = glm::vec2(model[(i + 1) % m_size]) - glm::vec2(model[i]);
+            float angle = std::atan2(-edge.x, edge.y);
+            if (angle < 0.f)
+                angle += 2.f * (float)M_PI;
+            m_packed[i] = {(std::uint16_t)std::lround(q.x), (std::uint16_t)std::lround(q.y),
+                           (std::uint16_t)((std::uint32_t)std::lround(angle * 65536.f / (2.f * (float)M_PI)) % 65536)};
+        }
+    }
+
+    // Normals transform with the inverse transpose of the linear part, which only matters for non-uniform scales
+    glm::vec2 decode_global_normal(const std::size_t index) const
+    {
+        const glm::vec2 n = decode_model_normal(index);
+        const float a = m_gtransform[0][0], b = m_gtransform[0][1], c = m_gtransform[1][0], d = m_gtransform[1][1];
+        const glm::vec2 gn = glm::vec2(d * n.x - b * n.y, a * n.y - c * n.x);
+        return glm::normalize(a * d - b * c < 0.f ? -gn : gn);
+    }
+
+    glm::vec2 to_model(const glm::vec2 &p) const
+    {
+        const float a = m_gtransform[0][0], b = m_gtransform[0][1], c = m_gtransform[1][0], d = m_gtransform[1][1];
+        const glm::vec2 rel = p - glm::vec2(m_gtransform[2]);
+        return glm::vec2(d * rel.x - c * rel.y, a * rel.y - b * rel.x) / (a * d - b * c);
+    }
+
+    void on_shape_transform_update(const glm::mat3 &ltransform, const glm::mat3 &gtransform) override
+    {
+        shape2D::on_shape_transform_update(ltransform, gtransform);
+        m_gtransform = gtransform;
+    }
+};
+} // namespace geo
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "geo/shapes2D/shape2D.hpp"
+#include "kit/utility/transform.hpp"
+#include <glm/mat3x3.hpp>
+#include <vector>
+#include <cstdint>
+
+namespace geo
+{
+// Caches the global matrix of parent transforms so that it is computed once per change instead of once per child
+// shape update. Every node wraps an externally owned transform and stores its global matrix along with a version
+// that increases whenever the matrix changes. A node is recomputed when its local transform changed or when the
+// version of its parent differs from the one it was computed with, so dirtiness propagates down whole subtrees.
+// Reparenting a wrapped transform moves its node under the node of the new parent transform, which must exist.
+// update() sweeps the nodes in depth order and updates the shapes attached to every recomputed node in one batch
+class transform_hierarchy
+{
+  public:
+    using node_id = std::uint32_t;
+    static inline constexpr node_id NONE = UINT32_MAX;
+
+    transform_hierarchy() = default;
+    ~transform_hierarchy();
+
+    transform_hierarchy(const transform_hierarchy &) = delete;
+    transform_hierarchy &operator=(const transform_hierarchy &) = delete;
+
+    // The transform must outlive the node, and its parent must be the transform of the parent node (or null)
+    node_id add(const kit::transform2D<float> &transform, node_id parent = NONE);
+
+    // Removes the node and all its descendants. Their shapes are detached but keep their parent transform
+    void remove(node_id node);
+
+    // Parents the shape to the node transform. The shape must be detached before it is destroyed. While attached, its
+    // own updates reuse the cached global matrix of the node, so that changes in the node or its ancestors reach the
+    // shape on the next update()
+    void attach(shape2D &shape, node_id node);
+    void detach(shape2D &shape, node_id node);
+
+    // Forces the node to be recomputed in the next update. Changes in the local transform are detected automatically
+    void mark_dirty(node_id node);
+
+    void update();
+
+    const glm::mat3 &gtransform(node_id node) const;
+    const glm::mat3 &inverse_gtransform(node_id node) const;
+    std::uint64_t version(node_id node) const;
+
+    // Cached global matrix of the node if it exists and still wraps transform, or null
+    const glm::mat3 *cached_gtransform(node_id node, const kit::transform2D<float> &transform) const;
+
+    // Equivalent to shape2D::gtranslate for a shape attached to node, using the cached inverse matrix
+    void gtranslate(shape2D &shape, node_id node, const glm::vec2 &dpos) const;
+
+    bool contains(node_id node) const;
+    std::size_t size() const;
+    void clear();
+
+  private:
+    struct node
+    {
+        const kit::transform2D<float> *transform;
+        node_id parent;
+        std::uint32_t depth;
+
+        glm::mat3 gtransform{1.f};
+        mutable glm::mat3 inverse_gtransform{1.f};
+
+        std::uint64_t version = 0;
+        std::uint64_t parent_version = 0;
+        mutable std::uint64_t inverse_version = 0;
+
+        // Local transform values the global matrix was last computed with
+        glm::vec2 position{0.f};
+        glm::vec2 scale{0.f};
+        glm::vec2 origin{0.f};
+        float rotation = 0.f;
+        const kit::transform2D<float> *parent_transform = nullptr;
+
+        bool dirty = true;
+        bool alive = true;
+        std::vector<shape2D *> shapes;
+    };
+
+    std::vector<node> m_nodes;
+    std::vector<node_id> m_order;
+    std::vector<node_id> m_free;
+    bool m_order_dirty = false;
+
+    node_id find(const kit::transform2D<float> *transform) const;
+    // Nodes whose transform was given another parent are moved under the node of that parent
+    void rebind_reparented();
+    bool local_changed(const node &nd) const;
+    void unlink_shapes(node &nd);
+};
+} // namespace geo
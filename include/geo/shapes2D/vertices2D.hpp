@@ -7,6 +7,7 @@
 namespace geo
 {
 template <std::size_t N> class polygon;
+template <std::size_t N> class rounded_polygon;
 template <std::size_t N>
     requires(N >= 3)
 class vertices2D
@@ -65,5 +66,6 @@ class vertices2D
     }
 
     friend class polygon<N>;
+    friend class rounded_polygon<N>;
 };
 } // namespace geo
\ No newline at end of file
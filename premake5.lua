@@ -1,3 +1,28 @@
+-- Profiling switches add inline code to public headers, such as sat, clipping_contacts and the scene codec, so every
+-- project including them must be built with the same defines. Projects using geometry call geo_profiling_defines()
+newoption {
+   trigger = "geo-stats",
+   description = "Count iterations and early exits of the geometry algorithms (GEO_ENABLE_STATS)"
+}
+newoption {
+   trigger = "geo-recorder",
+   description = "Record narrow phase queries to a trace for geometry-replay (GEO_ENABLE_RECORDER)"
+}
+newoption {
+   trigger = "geo-timeline",
+   description = "Record geometry hot paths to a per-thread timeline (GEO_ENABLE_TIMELINE)"
+}
+
+function geo_profiling_defines()
+   filter "options:geo-stats"
+      defines "GEO_ENABLE_STATS"
+   filter "options:geo-recorder"
+      defines "GEO_ENABLE_RECORDER"
+   filter "options:geo-timeline"
+      defines "GEO_ENABLE_TIMELINE"
+   filter {}
+end
+
 project "geometry"
 language "C++"
 cppdialect "c++20"
@@ -13,6 +38,8 @@ filter "system:macosx"
    }
 filter {}
 
+geo_profiling_defines()
+
 pchheader "geo/internal/pch.hpp"
 pchsource "src/internal/pch.cpp"
 
@@ -34,3 +61,125 @@ includedirs {
    "%{wks.location}/vendor/glm",
    "%{wks.location}/vendor/spdlog/include"
 }
+
+project "geometry-bench"
+language "C++"
+cppdialect "c++20"
+kind "ConsoleApp"
+
+filter "system:macosx"
+   buildoptions {
+      "-Wall",
+      "-Wextra",
+      "-Wpedantic",
+      "-Wconversion",
+      "-Wno-unused-parameter",
+      "-Wno-sign-conversion"
+   }
+filter {}
+
+geo_profiling_defines()
+
+staticruntime "off"
+
+targetdir("bin/" .. outputdir)
+objdir("build/" .. outputdir)
+
+files {
+   "bench/**.cpp",
+   "bench/**.hpp"
+}
+
+includedirs {
+   "include",
+   "%{wks.location}/cpp-kit/include",
+   "%{wks.location}/vendor/yaml-cpp/include",
+   "%{wks.location}/vendor/glm",
+   "%{wks.location}/vendor/spdlog/include"
+}
+
+links {
+   "geometry",
+   "cpp-kit"
+}
+
+project "geometry-replay"
+language "C++"
+cppdialect "c++20"
+kind "ConsoleApp"
+
+filter "system:macosx"
+   buildoptions {
+      "-Wall",
+      "-Wextra",
+      "-Wpedantic",
+      "-Wconversion",
+      "-Wno-unused-parameter",
+      "-Wno-sign-conversion"
+   }
+filter {}
+
+geo_profiling_defines()
+
+staticruntime "off"
+
+targetdir("bin/" .. outputdir)
+objdir("build/" .. outputdir)
+
+files {
+   "tools/replay/**.cpp"
+}
+
+includedirs {
+   "include",
+   "%{wks.location}/cpp-kit/include",
+   "%{wks.location}/vendor/yaml-cpp/include",
+   "%{wks.location}/vendor/glm",
+   "%{wks.location}/vendor/spdlog/include"
+}
+
+links {
+   "geometry",
+   "cpp-kit"
+}
+
+project "geometry-tests"
+language "C++"
+cppdialect "c++20"
+kind "ConsoleApp"
+
+filter "system:macosx"
+   buildoptions {
+      "-Wall",
+      "-Wextra",
+      "-Wpedantic",
+      "-Wconversion",
+      "-Wno-unused-parameter",
+      "-Wno-sign-conversion"
+   }
+filter {}
+
+geo_profiling_defines()
+
+staticruntime "off"
+
+targetdir("bin/" .. outputdir)
+objdir("build/" .. outputdir)
+
+files {
+   "tests/**.cpp",
+   "tests/**.hpp"
+}
+
+includedirs {
+   "include",
+   "%{wks.location}/cpp-kit/include",
+   "%{wks.location}/vendor/yaml-cpp/include",
+   "%{wks.location}/vendor/glm",
+   "%{wks.location}/vendor/spdlog/include"
+}
+
+links {
+   "geometry",
+   "cpp-kit"
+}
@@ -0,0 +1,119 @@
+#include "geo/internal/pch.hpp"
+#include "geo/algorithm/convex_hull.hpp"
+
+#include "kit/utility/utils.hpp"
+#include <queue>
+
+namespace geo
+{
+std::vector<glm::vec2> convex_hull(const std::span<const glm::vec2> points)
+{
+    KIT_PERF_FUNCTION()
+    std::vector<glm::vec2> sorted{points.begin(), points.end()};
+    std::sort(sorted.begin(), sorted.end(),
+              [](const glm::vec2 &v1, const glm::vec2 &v2) { return v1.x < v2.x || (v1.x == v2.x && v1.y < v2.y); });
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    if (sorted.size() < 3)
+        return sorted;
+
+    // Turns smaller than this are treated as collinear, relative to the squared extent of the point cloud
+    const glm::vec2 extent = sorted.back() - sorted.front();
+    const float tolerance = 4.f * std::numeric_limits<float>::epsilon() *
+                            std::max(glm::length2(extent), std::numeric_limits<float>::min());
+    const auto turns_left = [tolerance](const glm::vec2 &p1, const glm::vec2 &p2, const glm::vec2 &p3) {
+        return kit::cross2D(p2 - p1, p3 - p1) > tolerance;
+    };
+
+    std::vector<glm::vec2> hull(2 * sorted.size());
+    std::size_t size = 0;
+    for (const glm::vec2 &p : sorted)
+    {
+        while (size >= 2 && !turns_left(hull[size - 2], hull[size - 1], p))
+            size--;
+        hull[size++] = p;
+    }
+    const std::size_t lower_size = size + 1;
+    for (auto it = sorted.rbegin() + 1; it != sorted.rend(); ++it)
+    {
+        while (size >= lower_size && !turns_left(hull[size - 2], hull[size - 1], *it))
+            size--;
+        hull[size++] = *it;
+    }
+    hull.resize(size - 1);
+    return hull;
+}
+
+void reduce_convex_hull(std::vector<glm::vec2> &hull, const std::size_t max_vertices, const float max_area_loss)
+{
+    KIT_ASSERT_ERROR(max_vertices >= 3, "Cannot reduce a hull to less than 3 vertices - max vertices: {0}",
+                     max_vertices)
+    KIT_PERF_FUNCTION()
+    const std::size_t count = hull.size();
+    if (count <= 3)
+        return;
+
+    struct candidate
+    {
+        float area;
+        std::size_t index;
+        std::uint32_t version;
+
+        bool operator>(const candidate &other) const
+        {
+            return area > other.area;
+        }
+    };
+
+    std::vector<std::size_t> prev(count), next(count);
+    std::vector<std::uint32_t> versions(count, 0);
+    std::vector<bool> removed(count, false);
+    const auto area_loss = [&](const std::size_t i) {
+        return 0.5f * std::abs(kit::cross2D(hull[i] - hull[prev[i]], hull[next[i]] - hull[prev[i]]));
+    };
+
+    std::priority_queue<candidate, std::vector<candidate>, std::greater<candidate>> queue;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        prev[i] = (i + count - 1) % count;
+        next[i] = (i + 1) % count;
+    }
+    for (std::size_t i = 0; i < count; i++)
+        queue.push({area_loss(i), i, 0});
+
+    std::size_t size = count;
+    while (size > 3 && !queue.empty())
+    {
+        const candidate cand = queue.top();
+        if (removed[cand.index] || cand.version != versions[cand.index])
+        {
+            queue.pop();
+            continue;
+        }
+        if (size <= max_vertices && cand.area > max_area_loss)
+            break;
+        queue.pop();
+
+        const std::size_t p = prev[cand.index], n = next[cand.index];
+        removed[cand.index] = true;
+        next[p] = n;
+        prev[n] = p;
+        size--;
+
+        queue.push({area_loss(p), p, ++versions[p]});
+        queue.push({area_loss(n), n, ++versions[n]});
+    }
+
+    std::size_t start = 0;
+    while (removed[start])
+        start++;
+    std::vector<glm::vec2> reduced;
+    reduced.reserve(size);
+    std::size_t i = start;
+    do
+    {
+        reduced.push_back(hull[i]);
+        i = next[i];
+    } while (i != start);
+    hull = std::move(reduced);
+}
+} // namespace geo
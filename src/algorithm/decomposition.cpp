@@ -0,0 +1,169 @@
+#include "geo/internal/pch.hpp"
+#include "geo/algorithm/decomposition.hpp"
+
+#include "kit/utility/utils.hpp"
+#include <map>
+
+namespace geo
+{
+using piece = std::vector<std::size_t>;
+using edge = std::pair<std::size_t, std::size_t>;
+
+static bool inside_triangle(const glm::vec2 &p, const glm::vec2 &a, const glm::vec2 &b, const glm::vec2 &c)
+{
+    return kit::cross2D(b - a, p - a) >= 0.f && kit::cross2D(c - b, p - b) >= 0.f &&
+           kit::cross2D(a - c, p - c) >= 0.f;
+}
+
+static std::vector<piece> ear_clipping(const std::vector<glm::vec2> &outline, const float tolerance)
+{
+    std::vector<std::size_t> remaining(outline.size());
+    for (std::size_t i = 0; i < remaining.size(); i++)
+        remaining[i] = i;
+
+    std::vector<piece> triangles;
+    triangles.reserve(outline.size() - 2);
+
+    std::size_t i = 0;
+    std::size_t attempts = 0;
+    while (remaining.size() > 3)
+    {
+        const std::size_t size = remaining.size();
+        const std::size_t ip = remaining[(i + size - 1) % size], ic = remaining[i % size],
+                          in = remaining[(i + 1) % size];
+        const glm::vec2 &prev = outline[ip], &curr = outline[ic], &next = outline[in];
+        const float turn = kit::cross2D(curr - prev, next - curr);
+
+        bool ear = turn > tolerance;
+        for (std::size_t j = 0; ear && j < size; j++)
+        {
+            const std::size_t k = remaining[j];
+            if (k != ip && k != ic && k != in && inside_triangle(outline[k], prev, curr, next))
+                ear = false;
+        }
+
+        // Collinear vertices are dropped without emitting a triangle. If no ear can be found because of numerical
+        // issues, the vertex is clipped anyway to guarantee termination
+        const bool collinear = std::abs(turn) <= tolerance;
+        if (ear || collinear || attempts > size)
+        {
+            if (!collinear)
+                triangles.push_back({ip, ic, in});
+            remaining.erase(remaining.begin() + (std::ptrdiff_t)(i % size));
+            attempts = 0;
+            continue;
+        }
+        i = (i + 1) % size;
+        attempts++;
+    }
+    if (std::abs(kit::cross2D(outline[remaining[1]] - outline[remaining[0]],
+                              outline[remaining[2]] - outline[remaining[1]])) > tolerance)
+        triangles.push_back({remaining[0], remaining[1], remaining[2]});
+    return triangles;
+}
+
+static bool convex_corner(const std::vector<glm::vec2> &outline, const piece &pc, const std::size_t index,
+                          const float tolerance)
+{
+    const std::size_t size = pc.size();
+    const glm::vec2 &prev = outline[pc[(index + size - 1) % size]];
+    const glm::vec2 &curr = outline[pc[index]];
+    const glm::vec2 &next = outline[pc[(index + 1) % size]];
+    return kit::cross2D(curr - prev, next - curr) >= -tolerance;
+}
+
+// Joins two pieces sharing the diagonal u -> v (in pc1) and v -> u (in pc2)
+static piece merge_pieces(const piece &pc1, const piece &pc2, const std::size_t u, const std::size_t v)
+{
+    piece merged;
+    merged.reserve(pc1.size() + pc2.size() - 2);
+
+    const std::size_t start1 = (std::size_t)(std::find(pc1.begin(), pc1.end(), v) - pc1.begin());
+    for (std::size_t i = 0; i < pc1.size(); i++)
+        merged.push_back(pc1[(start1 + i) % pc1.size()]);
+
+    const std::size_t start2 = (std::size_t)(std::find(pc2.begin(), pc2.end(), u) - pc2.begin());
+    for (std::size_t i = 1; i < pc2.size() - 1; i++)
+        merged.push_back(pc2[(start2 + i) % pc2.size()]);
+    return merged;
+}
+
+std::vector<std::vector<glm::vec2>> convex_decomposition(const std::span<const glm::vec2> outline,
+                                                         const std::size_t max_vertices)
+{
+    KIT_ASSERT_ERROR(outline.size() >= 3, "Cannot decompose an outline with less than 3 vertices - vertices: {0}",
+                     outline.size())
+    KIT_ASSERT_ERROR(max_vertices >= 3, "Cannot decompose into pieces of less than 3 vertices - max vertices: {0}",
+                     max_vertices)
+    KIT_PERF_FUNCTION()
+
+    std::vector<glm::vec2> ccw{outline.begin(), outline.end()};
+    float area = 0.f;
+    glm::vec2 min = ccw[0], max = ccw[0];
+    for (std::size_t i = 0; i < ccw.size(); i++)
+    {
+        area += kit::cross2D(ccw[i], ccw[(i + 1) % ccw.size()]);
+        min = glm::min(min, ccw[i]);
+        max = glm::max(max, ccw[i]);
+    }
+    if (area < 0.f)
+        std::reverse(ccw.begin(), ccw.end());
+    const float tolerance = 16.f * std::numeric_limits<float>::epsilon() * glm::length2(max - min);
+
+    std::vector<piece> pieces = ear_clipping(ccw, tolerance);
+    std::vector<bool> alive(pieces.size(), true);
+
+    std::map<edge, std::size_t> owners;
+    for (std::size_t i = 0; i < pieces.size(); i++)
+        for (std::size_t j = 0; j < 3; j++)
+            owners[{pieces[i][j], pieces[i][(j + 1) % 3]}] = i;
+
+    std::vector<edge> diagonals;
+    for (const auto &[e, owner] : owners)
+        if (e.first < e.second && owners.contains({e.second, e.first}))
+            diagonals.push_back(e);
+
+    for (const auto &[u, v] : diagonals)
+    {
+        const std::size_t p1 = owners.at({u, v}), p2 = owners.at({v, u});
+        if (pieces[p1].size() + pieces[p2].size() - 2 > max_vertices)
+            continue;
+
+        const piece merged = merge_pieces(pieces[p1], pieces[p2], u, v);
+        const std::size_t iu = (std::size_t)(std::find(merged.begin(), merged.end(), u) - merged.begin());
+        const std::size_t iv = (std::size_t)(std::find(merged.begin(), merged.end(), v) - merged.begin());
+        if (!convex_corner(ccw, merged, iu, tolerance) || !convex_corner(ccw, merged, iv, tolerance))
+            continue;
+
+        owners.erase({u, v});
+        owners.erase({v, u});
+        for (std::size_t i = 0; i < pieces[p2].size(); i++)
+        {
+            const edge e{pieces[p2][i], pieces[p2][(i + 1) % pieces[p2].size()]};
+            if (e != edge{v, u})
+                owners[e] = p1;
+        }
+        pieces[p1] = merged;
+        alive[p2] = false;
+    }
+
+    std::vector<std::vector<glm::vec2>> result;
+    for (std::size_t i = 0; i < pieces.size(); i++)
+    {
+        if (!alive[i])
+            continue;
+        // Merging may leave collinear vertices where a diagonal met the outline
+        std::vector<glm::vec2> &verts = result.emplace_back();
+        const piece &pc = pieces[i];
+        for (std::size_t j = 0; j < pc.size(); j++)
+        {
+            const glm::vec2 &prev = ccw[pc[(j + pc.size() - 1) % pc.size()]];
+            const glm::vec2 &curr = ccw[pc[j]];
+            const glm::vec2 &next = ccw[pc[(j + 1) % pc.size()]];
+            if (std::abs(kit::cross2D(curr - prev, next - curr)) > tolerance)
+                verts.push_back(curr);
+        }
+    }
+    return result;
+}
+} // namespace geo
@@ -0,0 +1,272 @@
+#include "geo/internal/pch.hpp"
+#include "geo/algorithm/gjk_batch.hpp"
+#include "geo/profiling/timeline.hpp"
+
+#include <bit>
+
+namespace geo
+{
+template <class T> using lanes = std::array<T, GJK_LANES>;
+
+struct lane_vec2
+{
+    lanes<float> x;
+    lanes<float> y;
+};
+
+// Vertex i of lane l is stored at i * GJK_LANES + l, so that every step of the support point search loads GJK_LANES
+// consecutive floats. Lanes with fewer vertices than max_size repeat their last vertex, which never replaces the current
+// maximum
+struct lane_polygons
+{
+    std::vector<float> x;
+    std::vector<float> y;
+    lane_vec2 centroids;
+    std::uint32_t max_size = 0;
+};
+
+struct lane_simplex
+{
+    std::array<lane_vec2, 3> points{};
+    std::array<lane_vec2, 3> supports1{};
+    std::array<lane_vec2, 3> supports2{};
+};
+
+// Same tie breaking as polygon::support_point. The maximum is kept in locals, which the compiler knows do not alias the
+// vertices, and the coordinates are selected with bit masks instead of branches, so that the lane loop becomes a vector
+// compare and a few logical operations
+static void support_points(const lane_polygons &polys, const lane_vec2 &dir, lane_vec2 &result)
+{
+    const float *x = polys.x.data(), *y = polys.y.data();
+    const lanes<float> &cx = polys.centroids.x, &cy = polys.centroids.y;
+    lanes<float> max_dot;
+    lanes<std::uint32_t> max_x, max_y;
+    for (std::size_t l = 0; l < GJK_LANES; l++)
+    {
+        max_dot[l] = dir.x[l] * (x[l] - cx[l]) + dir.y[l] * (y[l] - cy[l]);
+        max_x[l] = std::bit_cast<std::uint32_t>(x[l]);
+        max_y[l] = std::bit_cast<std::uint32_t>(y[l]);
+    }
+    for (std::uint32_t i = 1; i < polys.max_size; i++)
+    {
+        x += GJK_LANES;
+        y += GJK_LANES;
+        // At -O3 GCC fully unrolls the lane loop before it gets the chance to vectorize it
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC unroll 1
+#endif
+        for (std::size_t l = 0; l < GJK_LANES; l++)
+        {
+            const float dot = dir.x[l] * (x[l] - cx[l]) + dir.y[l] * (y[l] - cy[l]);
+            const std::uint32_t greater = 0u - (std::uint32_t)(dot > max_dot[l]);
+            max_dot[l] = std::max(max_dot[l], dot);
+            max_x[l] = (std::bit_cast<std::uint32_t>(x[l]) & greater) | (max_x[l] & ~greater);
+            max_y[l] = (std::bit_cast<std::uint32_t>(y[l]) & greater) | (max_y[l] & ~greater);
+        }
+    }
+    for (std::size_t l = 0; l < GJK_LANES; l++)
+    {
+        result.x[l] = std::bit_cast<float>(max_x[l]);
+        result.y[l] = std::bit_cast<float>(max_y[l]);
+    }
+}
+
+static void load_polygons(lane_polygons &polys, const lanes<const gjk_batch_polygon *> &sources,
+                          const lanes<glm::vec2> &centroids)
+{
+    polys.max_size = 0;
+    for (std::size_t l = 0; l < GJK_LANES; l++)
+    {
+        KIT_ASSERT_ERROR(sources[l]->size > 0, "Cannot run gjk on a polygon without vertices")
+        polys.centroids.x[l] = centroids[l].x;
+        polys.centroids.y[l] = centroids[l].y;
+        polys.max_size = std::max(polys.max_size, (std::uint32_t)sources[l]->size);
+    }
+
+    polys.x.resize(polys.max_size * GJK_LANES);
+    polys.y.resize(polys.max_size * GJK_LANES);
+    for (std::size_t l = 0; l < GJK_LANES; l++)
+    {
+        const gjk_batch_polygon &source = *sources[l];
+        source.load(source.poly, polys.x.data() + l, polys.y.data() + l);
+        const std::size_t last = (source.size - 1) * GJK_LANES + l;
+        for (std::size_t i = source.size; i < polys.max_size; i++)
+        {
+            polys.x[i * GJK_LANES + l] = polys.x[last];
+            polys.y[i * GJK_LANES + l] = polys.y[last];
+        }
+    }
+}
+
+static void write_result(const lane_simplex &simplex, const std::size_t lane, const bool intersect,
+                         gjk_result &result)
+{
+    result.intersect = intersect;
+    for (std::size_t i = 0; i < 3; i++)
+    {
+        result.simplex[i] = {simplex.points[i].x[lane], simplex.points[i].y[lane]};
+        result.supports1[i] = {simplex.supports1[i].x[lane], simplex.supports1[i].y[lane]};
+        result.supports2[i] = {simplex.supports2[i].x[lane], simplex.supports2[i].y[lane]};
+    }
+}
+
+static void push(lane_simplex &simplex, const std::size_t index, const lane_vec2 &sup1, const lane_vec2 &sup2)
+{
+    for (std::size_t l = 0; l < GJK_LANES; l++)
+    {
+        simplex.supports1[index].x[l] = sup1.x[l];
+        simplex.supports1[index].y[l] = sup1.y[l];
+        simplex.supports2[index].x[l] = sup2.x[l];
+        simplex.supports2[index].y[l] = sup2.y[l];
+        simplex.points[index].x[l] = sup1.x[l] - sup2.x[l];
+        simplex.points[index].y[l] = sup1.y[l] - sup2.y[l];
+    }
+}
+
+// Every active lane pushes one point per iteration and the triangle case always drops one, so all active lanes share
+// the same simplex size and the control flow stays uniform across the group
+static void solve_group(const lane_polygons &polys1, const lane_polygons &polys2, const std::size_t count,
+                        gjk_result *results)
+{
+    lane_simplex simplex;
+    lane_vec2 dir, neg_dir, sup1, sup2;
+    lanes<bool> active;
+    for (std::size_t l = 0; l < GJK_LANES; l++)
+    {
+        dir.x[l] = polys2.centroids.x[l] - polys1.centroids.x[l];
+        dir.y[l] = polys2.centroids.y[l] - polys1.centroids.y[l];
+        neg_dir.x[l] = -dir.x[l];
+        neg_dir.y[l] = -dir.y[l];
+        active[l] = l < count;
+    }
+
+    support_points(polys1, dir, sup1);
+    support_points(polys2, neg_dir, sup2);
+    push(simplex, 0, sup1, sup2);
+    for (std::size_t l = 0; l < GJK_LANES; l++)
+    {
+        dir.x[l] = -simplex.points[0].x[l];
+        dir.y[l] = -simplex.points[0].y[l];
+    }
+
+    std::size_t size = 1;
+    for (;;)
+    {
+        for (std::size_t l = 0; l < GJK_LANES; l++)
+        {
+            neg_dir.x[l] = -dir.x[l];
+            neg_dir.y[l] = -dir.y[l];
+        }
+        support_points(polys1, dir, sup1);
+        support_points(polys2, neg_dir, sup2);
+
+        bool any_active = false;
+        for (std::size_t l = 0; l < GJK_LANES; l++)
+        {
+            if (!active[l])
+                continue;
+            const float dot = (sup1.x[l] - sup2.x[l]) * dir.x[l] + (sup1.y[l] - sup2.y[l]) * dir.y[l];
+            if (dot <= 0.f)
+            {
+                write_result(simplex, l, false, results[l]);
+                active[l] = false;
+            }
+            any_active |= active[l];
+        }
+        if (!any_active)
+            return;
+
+        push(simplex, size, sup1, sup2);
+        if (size++ == 1)
+        {
+            const lane_vec2 &B = simplex.points[0], &A = simplex.points[1];
+            for (std::size_t l = 0; l < GJK_LANES; l++)
+            {
+                const float ABx = B.x[l] - A.x[l], ABy = B.y[l] - A.y[l];
+                const float crs = ABx * -A.y[l] - ABy * -A.x[l];
+                dir.x[l] = -ABy * crs;
+                dir.y[l] = ABx * crs;
+            }
+            continue;
+        }
+
+        lanes<bool> erase_first;
+        for (std::size_t l = 0; l < GJK_LANES; l++)
+        {
+            const lane_vec2 &C = simplex.points[0], &B = simplex.points[1], &A = simplex.points[2];
+            const float ABx = B.x[l] - A.x[l], ABy = B.y[l] - A.y[l];
+            const float ACx = C.x[l] - A.x[l], ACy = C.y[l] - A.y[l];
+
+            const float crs_ab = ACx * ABy - ACy * ABx;
+            const float ABperp_x = -ABy * crs_ab, ABperp_y = ABx * crs_ab;
+            const bool ab_side = -(ABperp_x * A.x[l] + ABperp_y * A.y[l]) >= 0.f;
+
+            const float crs_ac = ABx * ACy - ABy * ACx;
+            const float ACperp_x = -ACy * crs_ac, ACperp_y = ACx * crs_ac;
+            const bool ac_side = -(ACperp_x * A.x[l] + ACperp_y * A.y[l]) >= 0.f;
+
+            erase_first[l] = ab_side;
+            dir.x[l] = ab_side ? ABperp_x : ACperp_x;
+            dir.y[l] = ab_side ? ABperp_y : ACperp_y;
+            if (active[l] && !ab_side && !ac_side)
+            {
+                write_result(simplex, l, true, results[l]);
+                active[l] = false;
+            }
+        }
+
+        // Erasing the first point shifts the simplex down, while erasing the second only moves the last point
+        const auto erase = [&erase_first](std::array<lane_vec2, 3> &points) {
+            for (std::size_t l = 0; l < GJK_LANES; l++)
+            {
+                points[0].x[l] = erase_first[l] ? points[1].x[l] : points[0].x[l];
+                points[0].y[l] = erase_first[l] ? points[1].y[l] : points[0].y[l];
+                points[1].x[l] = points[2].x[l];
+                points[1].y[l] = points[2].y[l];
+            }
+        };
+        erase(simplex.points);
+        erase(simplex.supports1);
+        erase(simplex.supports2);
+        size = 2;
+    }
+}
+
+void gjk(const std::span<const gjk_batch_pair> pairs, const std::span<gjk_result> results)
+{
+    KIT_PERF_FUNCTION()
+    GEO_TIMELINE_FUNCTION(NARROW_PHASE)
+    KIT_ASSERT_ERROR(results.size() >= pairs.size(), "Result span is too small: {0} results for {1} pairs",
+                     results.size(), pairs.size())
+
+    // The vertex buffers are reused by every group
+    lane_polygons polys1, polys2;
+    for (std::size_t first = 0; first < pairs.size(); first += GJK_LANES)
+    {
+        const std::size_t count = std::min(GJK_LANES, pairs.size() - first);
+
+        // Padding lanes replicate the last pair of the group so that they always read valid vertices
+        lanes<const gjk_batch_polygon *> sources1, sources2;
+        lanes<glm::vec2> centroids1, centroids2;
+        for (std::size_t l = 0; l < GJK_LANES; l++)
+        {
+            const gjk_batch_pair &pair = pairs[first + std::min(l, count - 1)];
+            sources1[l] = &pair.poly1;
+            sources2[l] = &pair.poly2;
+            centroids1[l] = pair.centroid1;
+            centroids2[l] = pair.centroid2;
+        }
+        load_polygons(polys1, sources1, centroids1);
+        load_polygons(polys2, sources2, centroids2);
+
+        if (count == GJK_LANES)
+            solve_group(polys1, polys2, count, results.data() + first);
+        else
+        {
+            std::array<gjk_result, GJK_LANES> tail;
+            solve_group(polys1, polys2, count, tail.data());
+            std::copy_n(tail.begin(), count, results.begin() + (std::ptrdiff_t)first);
+        }
+    }
+}
+} // namespace geo
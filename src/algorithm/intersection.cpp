@@ -1,6 +1,9 @@
 #include "geo/internal/pch.hpp"
 #include "geo/algorithm/intersection.hpp"
 #include "geo/shapes2D/polygon.hpp"
+#include "geo/profiling/stats.hpp"
+#include "geo/profiling/recorder.hpp"
+#include "geo/profiling/timeline.hpp"
 
 #include "kit/utility/utils.hpp"
 
@@ -15,18 +18,26 @@ static glm::vec2 triple_cross(const glm::vec2 &v1, const glm::vec2 &v2, const gl
 struct arr3
 {
     std::array<glm::vec2, 3> &data;
+    std::array<glm::vec2, 3> &supports1;
+    std::array<glm::vec2, 3> &supports2;
     std::size_t size = 0;
 
-    void push(const glm::vec2 &val)
+    void push(const glm::vec2 &sup1, const glm::vec2 &sup2)
     {
-        data[size++] = val;
+        supports1[size] = sup1;
+        supports2[size] = sup2;
+        data[size++] = sup1 - sup2;
         KIT_ASSERT_ERROR(size <= 3, "Array size exceeds 3!")
     }
     void erase(const std::size_t index)
     {
         KIT_ASSERT_ERROR(size > 0, "Cannot erase element of empty array!")
         for (std::size_t i = index; i < size - 1; i++)
+        {
             data[i] = data[i + 1];
+            supports1[i] = supports1[i + 1];
+            supports2[i] = supports2[i + 1];
+        }
         --size;
     }
 };
@@ -58,95 +69,438 @@ static bool triangle_case(arr3 &simplex, glm::vec2 &dir)
     return true;
 }
 
+static glm::vec2 shape_support(const shape2D &sh, const glm::vec2 &direction)
+{
+    return sh.support_point(direction);
+}
+static glm::vec2 core_support(const shape2D &sh, const glm::vec2 &direction)
+{
+    return sh.core_support_point(direction);
+}
+
 gjk_result gjk(const shape2D &sh1, const shape2D &sh2)
 {
     KIT_PERF_FUNCTION()
+    GEO_TIMELINE_FUNCTION(NARROW_PHASE)
     KIT_ASSERT_WARN(!dynamic_cast<const circle *>(&sh1) || !dynamic_cast<const circle *>(&sh2),
                     "Using gjk algorithm to check if two circles are intersecting is overkill")
+    GEO_RECORD(recorder::record_gjk(sh1, sh2);)
 
-    gjk_result result{false, {}};
-    arr3 simplex{result.simplex};
+    gjk_result result{false, {}, {}, {}};
+    arr3 simplex{result.simplex, result.supports1, result.supports2};
 
     glm::vec2 dir = sh2.gcentroid() - sh1.gcentroid();
-    const glm::vec2 supp = sh1.support_point(dir) - sh2.support_point(-dir);
-    simplex.push(supp);
-    dir = -supp;
+    simplex.push(sh1.support_point(dir), sh2.support_point(-dir));
+    dir = -simplex.data[0];
+    GEO_STATS(std::uint32_t iterations = 0;)
 
     for (;;)
     {
-        const glm::vec2 A = sh1.support_point(dir) - sh2.support_point(-dir);
-        if (glm::dot(A, dir) <= 0.f)
+        GEO_STATS(iterations++;)
+        const glm::vec2 sup1 = sh1.support_point(dir), sup2 = sh2.support_point(-dir);
+        if (glm::dot(sup1 - sup2, dir) <= 0.f)
+        {
+            GEO_STATS(stats::record_gjk(sh1, sh2, iterations, 2 * iterations + 2, false);)
             return result;
+        }
 
-        simplex.push(A);
+        simplex.push(sup1, sup2);
         if (simplex.size == 2)
             line_case(simplex, dir);
         else if (triangle_case(simplex, dir))
         {
             result.intersect = true;
+            GEO_STATS(stats::record_gjk(sh1, sh2, iterations, 2 * iterations + 2, true);)
             return result;
         }
     }
 }
 
-mtv_result epa(const shape2D &sh1, const shape2D &sh2, const std::array<glm::vec2, 3> &simplex, const float threshold)
+struct epa_vertex
 {
-    KIT_ASSERT_ERROR(threshold > 0.f, "EPA Threshold must be greater than 0: {0}", threshold)
-    KIT_PERF_FUNCTION()
-
-    std::vector<glm::vec2> hull;
-    hull.reserve(10);
-    hull.insert(hull.end(), simplex.begin(), simplex.end());
+    glm::vec2 point;
+    glm::vec2 support1;
+    glm::vec2 support2;
+    // Direction in which the support points were queried, when known
+    glm::vec2 direction{0.f};
+};
 
+// The unit normal of the closest edge is written to normal, and the witness points are computed, even when the origin
+// lies on that edge and the result is invalid because of its null mtv
+template <auto Support>
+static epa_result expand_polytope(const shape2D &sh1, const shape2D &sh2, std::vector<epa_vertex> &hull,
+                                  const float threshold, glm::vec2 &normal)
+{
     float min_dist = FLT_MAX;
-    mtv_result result{false, glm::vec2(0.f)};
+    epa_result result{};
+    std::size_t min_index = 0;
+    GEO_STATS(std::uint32_t iterations = 0;)
     for (;;)
     {
-        std::size_t min_index;
+        GEO_STATS(iterations++;)
         for (std::size_t i = 0; i < hull.size(); i++)
         {
             const std::size_t j = (i + 1) % hull.size();
 
-            const glm::vec2 &p1 = hull[i], &p2 = hull[j];
+            const glm::vec2 &p1 = hull[i].point, &p2 = hull[j].point;
             const glm::vec2 edge = p2 - p1;
 
-            glm::vec2 normal = glm::normalize(glm::vec2(edge.y, -edge.x));
-            float dist = glm::dot(normal, p1);
-            if (dist < 0.f)
+            glm::vec2 edge_normal = glm::normalize(glm::vec2(edge.y, -edge.x));
+            float dist = glm::dot(edge_normal, p1);
+
+            // When the origin lies on the edge, the normal is oriented away from the rest of the polytope instead
+            const bool inwards = kit::approaches_zero(dist)
+                                     ? glm::dot(edge_normal, hull[(j + 1) % hull.size()].point - p1) > 0.f
+                                     : dist < 0.f;
+            if (inwards)
             {
                 dist *= -1.f;
-                normal *= -1.f;
+                edge_normal *= -1.f;
             }
             if (dist < min_dist)
             {
                 min_dist = dist;
                 min_index = j;
-                result.mtv = normal;
+                result.mtv = edge_normal;
             }
         }
         if (kit::approaches_zero(glm::length2(result.mtv)))
+        {
+            GEO_STATS(stats::record_epa(sh1, sh2, iterations, (std::uint32_t)hull.size(), 2 * (iterations - 1), true,
+                                        false);)
+            normal = result.mtv;
             return result;
+        }
 
-        const glm::vec2 support = sh1.support_point(result.mtv) - sh2.support_point(-result.mtv);
+        const glm::vec2 sup1 = Support(sh1, result.mtv), sup2 = Support(sh2, -result.mtv);
+        const glm::vec2 support = sup1 - sup2;
         const float sup_dist = glm::dot(result.mtv, support);
         const float diff = std::abs(sup_dist - min_dist);
         if (diff <= threshold)
             break;
-        hull.insert(hull.begin() + min_index, support);
+        hull.insert(hull.begin() + (std::ptrdiff_t)min_index, {support, sup1, sup2});
         min_dist = FLT_MAX;
     }
 
+    normal = result.mtv;
     result.mtv *= min_dist;
+
+    // The mtv is the closest point of the closest edge to the origin. Interpolating the support points that
+    // generated the edge with the same weights yields the witness points on each shape
+    const std::size_t size = hull.size();
+    const auto edge_weight = [&hull, size](const std::size_t j) {
+        const glm::vec2 &p1 = hull[(j + size - 1) % size].point, &p2 = hull[j].point;
+        const glm::vec2 edge = p2 - p1;
+        const float length2 = glm::length2(edge);
+        return kit::approaches_zero(length2) ? 0.f : -glm::dot(p1, edge) / length2;
+    };
+
+    // Collinear hull vertices tie the distance of consecutive edges, of which only one contains the closest point
+    float t = edge_weight(min_index);
+    for (std::size_t i = 0; i < size && (t < 0.f || t > 1.f); i++)
+    {
+        const std::size_t next = t > 1.f ? (min_index + 1) % size : (min_index + size - 1) % size;
+        const glm::vec2 &far = t > 1.f ? hull[next].point : hull[(min_index + size - 2) % size].point;
+        if (std::abs(glm::dot(normal, far) - min_dist) > threshold)
+            break;
+        min_index = next;
+        t = edge_weight(min_index);
+    }
+    t = std::clamp(t, 0.f, 1.f);
+
+    const epa_vertex &v1 = hull[(min_index + size - 1) % size];
+    const epa_vertex &v2 = hull[min_index];
+    result.witness1 = v1.support1 + t * (v2.support1 - v1.support1);
+    result.witness2 = v1.support2 + t * (v2.support2 - v1.support2);
+
     if (kit::approaches_zero(glm::length2(result.mtv)))
+    {
+        GEO_STATS(
+            stats::record_epa(sh1, sh2, iterations, (std::uint32_t)hull.size(), 2 * iterations, true, false);)
+        return result;
+    }
+    result.valid = true;
+    GEO_STATS(stats::record_epa(sh1, sh2, iterations, (std::uint32_t)hull.size(), 2 * iterations, false, true);)
+    return result;
+}
+
+mtv_result epa(const shape2D &sh1, const shape2D &sh2, const std::array<glm::vec2, 3> &simplex, const float threshold)
+{
+    KIT_ASSERT_ERROR(threshold > 0.f, "EPA Threshold must be greater than 0: {0}", threshold)
+    KIT_PERF_FUNCTION()
+    GEO_TIMELINE_FUNCTION(NARROW_PHASE)
+    GEO_RECORD(recorder::record_epa(sh1, sh2, simplex, threshold);)
+
+    // The support points behind the simplex are unknown, so the witness points cannot be trusted and are discarded
+    std::vector<epa_vertex> hull;
+    hull.reserve(10);
+    for (const glm::vec2 &p : simplex)
+        hull.push_back({p, glm::vec2(0.f), glm::vec2(0.f)});
+    glm::vec2 normal;
+    return expand_polytope<shape_support>(sh1, sh2, hull, threshold, normal);
+}
+
+epa_result epa(const shape2D &sh1, const shape2D &sh2, const gjk_result &gjk_res, const float threshold)
+{
+    KIT_ASSERT_ERROR(threshold > 0.f, "EPA Threshold must be greater than 0: {0}", threshold)
+    KIT_ASSERT_ERROR(gjk_res.intersect, "EPA requires the simplex of an intersecting gjk result")
+    KIT_PERF_FUNCTION()
+    GEO_TIMELINE_FUNCTION(NARROW_PHASE)
+    GEO_RECORD(recorder::record_epa(sh1, sh2, threshold);)
+
+    std::vector<epa_vertex> hull;
+    hull.reserve(10);
+    for (std::size_t i = 0; i < 3; i++)
+        hull.push_back({gjk_res.simplex[i], gjk_res.supports1[i], gjk_res.supports2[i]});
+    glm::vec2 normal;
+    return expand_polytope<shape_support>(sh1, sh2, hull, threshold, normal);
+}
+
+// Keeps the feature of the simplex closest to the origin and computes its barycentric weights. A triangle is only kept
+// whole when it encloses the origin
+static std::size_t reduce_simplex(std::array<epa_vertex, 3> &simplex, const std::size_t size,
+                                  std::array<float, 3> &weights)
+{
+    const auto keep_vertex = [&simplex, &weights](const std::size_t index) {
+        simplex[0] = simplex[index];
+        weights[0] = 1.f;
+        return std::size_t(1);
+    };
+    const auto keep_edge = [&simplex, &weights](const std::size_t index1, const std::size_t index2, const float w1,
+                                                const float w2) {
+        const epa_vertex v1 = simplex[index1], v2 = simplex[index2];
+        simplex[0] = v1;
+        simplex[1] = v2;
+        weights[0] = w1 / (w1 + w2);
+        weights[1] = w2 / (w1 + w2);
+        return std::size_t(2);
+    };
+
+    if (size == 1)
+        return keep_vertex(0);
+
+    const glm::vec2 &a = simplex[0].point, &b = simplex[1].point;
+    const glm::vec2 ab = b - a;
+    const float ab1 = glm::dot(b, ab), ab2 = -glm::dot(a, ab);
+    if (size == 2)
+    {
+        if (ab2 <= 0.f)
+            return keep_vertex(0);
+        if (ab1 <= 0.f)
+            return keep_vertex(1);
+        return keep_edge(0, 1, ab1, ab2);
+    }
+
+    const glm::vec2 &c = simplex[2].point;
+    const glm::vec2 ac = c - a, bc = c - b;
+    const float ac1 = glm::dot(c, ac), ac2 = -glm::dot(a, ac);
+    const float bc1 = glm::dot(c, bc), bc2 = -glm::dot(b, bc);
+
+    const float area = kit::cross2D(ab, ac);
+    const float abc1 = area * kit::cross2D(b, c), abc2 = area * kit::cross2D(c, a), abc3 = area * kit::cross2D(a, b);
+
+    if (ab2 <= 0.f && ac2 <= 0.f)
+        return keep_vertex(0);
+    if (ab1 > 0.f && ab2 > 0.f && abc3 <= 0.f)
+        return keep_edge(0, 1, ab1, ab2);
+    if (ac1 > 0.f && ac2 > 0.f && abc2 <= 0.f)
+        return keep_edge(0, 2, ac1, ac2);
+    if (ab1 <= 0.f && bc2 <= 0.f)
+        return keep_vertex(1);
+    if (ac1 <= 0.f && bc1 <= 0.f)
+        return keep_vertex(2);
+    if (bc1 > 0.f && bc2 > 0.f && abc1 <= 0.f)
+        return keep_edge(1, 2, bc1, bc2);
+    return 3;
+}
+
+// Distance from the origin to the boundary of the core difference along n. It is positive when the origin lies inside the
+// difference, and zero when n is an outward normal of the difference at the origin
+static float core_depth(const shape2D &sh1, const shape2D &sh2, const glm::vec2 &n)
+{
+    return glm::dot(n, sh1.core_support_point(n) - sh2.core_support_point(-n));
+}
+
+// The origin lies on the simplex, and therefore in the core difference. Its outward normals at the origin, if it lies on
+// its boundary, are searched among the directions that produced the simplex, the normals of its edge and the directions
+// along and across the centroids. The normal with the least depth is returned, the centroid direction winning ties
+static glm::vec2 touching_normal(const shape2D &sh1, const shape2D &sh2, const std::array<epa_vertex, 3> &simplex,
+                                 const std::size_t size, float &depth)
+{
+    std::array<glm::vec2, 7> candidates;
+    std::size_t count = 0;
+    const auto add = [&candidates, &count](const glm::vec2 &dir) {
+        if (!kit::approaches_zero(glm::length2(dir)))
+            candidates[count++] = glm::normalize(dir);
+    };
+
+    const glm::vec2 towards = sh2.gcentroid() - sh1.gcentroid();
+    add(towards);
+    for (std::size_t i = 0; i < size; i++)
+        add(simplex[i].direction);
+    if (size == 2)
+    {
+        const glm::vec2 edge = simplex[1].point - simplex[0].point;
+        add(glm::vec2(edge.y, -edge.x));
+        add(glm::vec2(-edge.y, edge.x));
+    }
+    add(glm::vec2(towards.y, -towards.x));
+    add(glm::vec2(-towards.y, towards.x));
+    if (count == 0)
+        add(glm::vec2(1.f, 0.f));
+
+    glm::vec2 normal = candidates[0];
+    depth = core_depth(sh1, sh2, normal);
+    for (std::size_t i = 1; i < count; i++)
+    {
+        const float d = core_depth(sh1, sh2, candidates[i]);
+        if (d < depth)
+        {
+            depth = d;
+            normal = candidates[i];
+        }
+    }
+    return normal;
+}
+
+// normal points from the core of sh1 towards the core of sh2. It is the direction between the witness points when the
+// cores are apart, and an outward normal of the core difference at the origin when they touch. When the simplex passes
+// through the origin but the cores overlap, the simplex is completed into a triangle enclosing the origin on one of
+// its edges, which epa is able to expand
+static distance_result core_distance(const shape2D &sh1, const shape2D &sh2, const std::uint32_t max_iterations,
+                                     std::array<epa_vertex, 3> &simplex, glm::vec2 &normal)
+{
+    distance_result result{false, 0.f, glm::vec2(0.f), glm::vec2(0.f)};
+    std::array<float, 3> weights{1.f, 0.f, 0.f};
+
+    glm::vec2 dir = sh2.gcentroid() - sh1.gcentroid();
+    if (kit::approaches_zero(glm::length2(dir)))
+        dir = glm::vec2(1.f, 0.f);
+    const glm::vec2 first1 = sh1.core_support_point(dir), first2 = sh2.core_support_point(-dir);
+    simplex[0] = {first1 - first2, first1, first2, dir};
+
+    std::size_t size = 1;
+    glm::vec2 closest = simplex[0].point;
+    for (std::uint32_t i = 0; i < max_iterations; i++)
+    {
+        const float dist2 = glm::length2(closest);
+        if (kit::approaches_zero(dist2))
+            break;
+
+        const glm::vec2 sup1 = sh1.core_support_point(-closest), sup2 = sh2.core_support_point(closest);
+        const glm::vec2 support = sup1 - sup2;
+        if (dist2 - glm::dot(closest, support) <= 1.e-5f * dist2)
+            break;
+
+        simplex[size++] = {support, sup1, sup2, -closest};
+        size = reduce_simplex(simplex, size, weights);
+        if (size == 3)
+        {
+            result.overlap = true;
+            return result;
+        }
+
+        const glm::vec2 next = size == 1 ? simplex[0].point
+                                         : weights[0] * simplex[0].point + weights[1] * simplex[1].point;
+        if (glm::length2(next) >= dist2)
+            break;
+        closest = next;
+    }
+
+    if (kit::approaches_zero(glm::length2(closest)))
+    {
+        float depth;
+        normal = touching_normal(sh1, sh2, simplex, size, depth);
+        if (size == 2 && !kit::approaches_zero(depth * depth))
+        {
+            const glm::vec2 edge = simplex[1].point - simplex[0].point;
+            const glm::vec2 across = glm::vec2(edge.y, -edge.x);
+            const glm::vec2 sup1 = sh1.core_support_point(across), sup2 = sh2.core_support_point(-across);
+            simplex[2] = {sup1 - sup2, sup1, sup2, across};
+            result.overlap = true;
+            return result;
+        }
+    }
+    else
+        normal = -glm::normalize(closest);
+
+    for (std::size_t i = 0; i < size; i++)
+    {
+        result.witness1 += weights[i] * simplex[i].support1;
+        result.witness2 += weights[i] * simplex[i].support2;
+    }
+    result.distance = glm::distance(result.witness1, result.witness2);
+    return result;
+}
+
+distance_result gjk_distance(const shape2D &sh1, const shape2D &sh2, const std::uint32_t max_iterations)
+{
+    KIT_PERF_FUNCTION()
+    GEO_TIMELINE_FUNCTION(NARROW_PHASE)
+    GEO_RECORD(recorder::record_gjk_distance(sh1, sh2, max_iterations);)
+    std::array<epa_vertex, 3> simplex;
+    glm::vec2 normal;
+    return core_distance(sh1, sh2, max_iterations, simplex, normal);
+}
+
+// Cores at the given distance along normal, which points from the core of sh1 towards the core of sh2. Overlapping
+// cores have a negative distance
+static epa_result rounded_normal_mtv(const glm::vec2 &p1, const float r1, const glm::vec2 &p2, const float r2,
+                                     const glm::vec2 &normal, const float distance)
+{
+    epa_result result{};
+    const float radius = r1 + r2;
+    if (distance >= radius)
         return result;
 
+    result.mtv = normal * (radius - distance);
+    result.witness1 = p1 + normal * r1;
+    result.witness2 = p2 - normal * r2;
     result.valid = true;
     return result;
 }
 
+static epa_result rounded_points_mtv(const glm::vec2 &p1, const float r1, const glm::vec2 &p2, const float r2)
+{
+    const glm::vec2 dir = p2 - p1;
+    const float dist2 = glm::length2(dir), radius = r1 + r2;
+    if (dist2 >= radius * radius || kit::approaches_zero(dist2))
+        return epa_result{};
+
+    const float dist = std::sqrt(dist2);
+    return rounded_normal_mtv(p1, r1, p2, r2, dir / dist, dist);
+}
+
+epa_result rounded_mtv(const shape2D &sh1, const shape2D &sh2, const float threshold)
+{
+    KIT_ASSERT_ERROR(threshold > 0.f, "EPA Threshold must be greater than 0: {0}", threshold)
+    KIT_PERF_FUNCTION()
+    GEO_TIMELINE_FUNCTION(NARROW_PHASE)
+    GEO_RECORD(recorder::record_rounded_mtv(sh1, sh2, threshold);)
+
+    std::array<epa_vertex, 3> simplex;
+    glm::vec2 normal;
+    const distance_result dist = core_distance(sh1, sh2, 32, simplex, normal);
+    const float r1 = sh1.core_radius(), r2 = sh2.core_radius();
+    if (!dist.overlap)
+        return rounded_normal_mtv(dist.witness1, r1, dist.witness2, r2, normal, dist.distance);
+
+    std::vector<epa_vertex> hull(simplex.begin(), simplex.end());
+    hull.reserve(10);
+    const epa_result core = expand_polytope<core_support>(sh1, sh2, hull, threshold, normal);
+
+    // Cores that only touch still overlap by the radii, along the normal of the polytope edge through the origin
+    if (!core.valid && !kit::approaches_zero(glm::length2(normal) - 1.f))
+        return core;
+    return rounded_normal_mtv(core.witness1, r1, core.witness2, r2, normal, -glm::length(core.mtv));
+}
+
 glm::vec2 mtv_support_contact_point(const shape2D &sh1, const shape2D &sh2, const glm::vec2 &mtv)
 {
     KIT_PERF_FUNCTION()
+    GEO_TIMELINE_FUNCTION(NARROW_PHASE)
+    GEO_STATS(stats::record_contact_point(sh1, sh2, 2);)
+    GEO_RECORD(recorder::record_contact_point(sh1, sh2, mtv);)
     const glm::vec2 sup1 = sh1.support_point(mtv), sup2 = sh2.support_point(-mtv);
     const float d1 = glm::length2(sh2.closest_direction_from(sup1 - mtv)),
                 d2 = glm::length2(sh1.closest_direction_from(sup2 + mtv));
@@ -191,4 +545,71 @@ glm::vec2 radius_distance_contact_point(const circle &c1, const circle &c2)
     const glm::vec2 dir = glm::normalize(c1.gcentroid() - c2.gcentroid());
     return c1.gcentroid() - dir * c1.radius();
 }
+
+bool intersects(const capsule &cap, const circle &circ)
+{
+    const float R = cap.radius() + circ.radius();
+    return glm::distance2(cap.closest_segment_point(circ.gcentroid()), circ.gcentroid()) < R * R;
+}
+epa_result mtv(const capsule &cap, const circle &circ)
+{
+    const glm::vec2 closest = cap.closest_segment_point(circ.gcentroid());
+    if (!kit::approaches_zero(glm::distance2(closest, circ.gcentroid())))
+        return rounded_points_mtv(closest, cap.radius(), circ.gcentroid(), circ.radius());
+
+    // The center of the circle lies on the segment, so it is pushed out along the segment normal
+    const glm::vec2 edge = cap.segment()[1] - cap.segment()[0];
+    const glm::vec2 normal =
+        kit::approaches_zero(glm::length2(edge)) ? glm::vec2(0.f, 1.f) : glm::normalize(glm::vec2(edge.y, -edge.x));
+
+    epa_result result;
+    result.mtv = normal * (cap.radius() + circ.radius());
+    result.witness1 = closest + normal * cap.radius();
+    result.witness2 = circ.gcentroid() - normal * circ.radius();
+    result.valid = true;
+    return result;
+}
+
+static bool segments_cross(const std::array<glm::vec2, 2> &seg1, const std::array<glm::vec2, 2> &seg2)
+{
+    const glm::vec2 dir1 = seg1[1] - seg1[0], dir2 = seg2[1] - seg2[0];
+    const float side1 = kit::cross2D(dir1, seg2[0] - seg1[0]), side2 = kit::cross2D(dir1, seg2[1] - seg1[0]);
+    const float side3 = kit::cross2D(dir2, seg1[0] - seg2[0]), side4 = kit::cross2D(dir2, seg1[1] - seg2[0]);
+    return side1 * side2 < 0.f && side3 * side4 < 0.f;
+}
+
+// Closest points of two segments that do not cross always include an endpoint of one of them
+static std::pair<glm::vec2, glm::vec2> closest_segment_points(const capsule &cap1, const capsule &cap2)
+{
+    const std::array<std::pair<glm::vec2, glm::vec2>, 4> candidates{
+        std::pair{cap1.segment()[0], cap2.closest_segment_point(cap1.segment()[0])},
+        std::pair{cap1.segment()[1], cap2.closest_segment_point(cap1.segment()[1])},
+        std::pair{cap1.closest_segment_point(cap2.segment()[0]), cap2.segment()[0]},
+        std::pair{cap1.closest_segment_point(cap2.segment()[1]), cap2.segment()[1]}};
+
+    std::size_t closest = 0;
+    for (std::size_t i = 1; i < candidates.size(); i++)
+        if (glm::distance2(candidates[i].first, candidates[i].second) <
+            glm::distance2(candidates[closest].first, candidates[closest].second))
+            closest = i;
+    return candidates[closest];
+}
+
+bool intersects(const capsule &cap1, const capsule &cap2)
+{
+    if (segments_cross(cap1.segment(), cap2.segment()))
+        return true;
+    const auto [p1, p2] = closest_segment_points(cap1, cap2);
+    const float R = cap1.radius() + cap2.radius();
+    return glm::distance2(p1, p2) < R * R;
+}
+epa_result mtv(const capsule &cap1, const capsule &cap2)
+{
+    if (segments_cross(cap1.segment(), cap2.segment()))
+        return rounded_mtv(cap1, cap2);
+    const auto [p1, p2] = closest_segment_points(cap1, cap2);
+    if (kit::approaches_zero(glm::distance2(p1, p2)))
+        return rounded_mtv(cap1, cap2);
+    return rounded_points_mtv(p1, cap1.radius(), p2, cap2.radius());
+}
 } // namespace geo
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include "geo/internal/pch.hpp"
+#include "geo/algorithm/nearest.hpp"
+#include "geo/algorithm/intersection.hpp"
+#include "geo/profiling/timeline.hpp"
+
+namespace geo
+{
+float shape_distance(const shape2D &shape, const glm::vec2 &point)
+{
+    if (shape.contains_point(point))
+        return 0.f;
+    return glm::length(shape.closest_direction_from(point));
+}
+
+float shape_distance(const shape2D &sh1, const shape2D &sh2)
+{
+    const distance_result result = gjk_distance(sh1, sh2);
+    if (result.overlap)
+        return 0.f;
+    return std::max(0.f, result.distance - sh1.core_radius() - sh2.core_radius());
+}
+
+std::size_t nearest_shapes(const static_bvh &bvh, const std::span<const shape2D *const> shapes,
+                           const glm::vec2 &point, const std::span<bvh_neighbor> neighbors, const float max_distance)
+{
+    KIT_PERF_FUNCTION()
+    GEO_TIMELINE_FUNCTION(BROAD_PHASE)
+    KIT_ASSERT_ERROR(shapes.size() == bvh.size(), "Shape count must match the primitives of the bvh: {0} != {1}",
+                     shapes.size(), bvh.size())
+    return bvh.nearest(
+        point, neighbors, [&shapes, &point](const std::uint32_t index) { return shape_distance(*shapes[index], point); },
+        max_distance);
+}
+
+std::size_t nearest_shapes(const static_bvh &bvh, const std::span<const shape2D *const> shapes, const shape2D &shape,
+                           const std::span<bvh_neighbor> neighbors, const float max_distance)
+{
+    KIT_PERF_FUNCTION()
+    GEO_TIMELINE_FUNCTION(BROAD_PHASE)
+    KIT_ASSERT_ERROR(shapes.size() == bvh.size(), "Shape count must match the primitives of the bvh: {0} != {1}",
+                     shapes.size(), bvh.size())
+    return bvh.nearest(
+        shape.bounding_box(), neighbors,
+        [&shapes, &shape](const std::uint32_t index) {
+            return shapes[index] == &shape ? FLT_MAX : shape_distance(*shapes[index], shape);
+        },
+        max_distance);
+}
+
+void nearest_shapes(const static_bvh &bvh, const std::span<const shape2D *const> shapes,
+                    const std::span<const glm::vec2> points, const std::size_t k,
+                    const std::span<bvh_neighbor> neighbors, const float max_distance)
+{
+    KIT_PERF_FUNCTION()
+    GEO_TIMELINE_FUNCTION(BROAD_PHASE)
+    KIT_ASSERT_ERROR(shapes.size() == bvh.size(), "Shape count must match the primitives of the bvh: {0} != {1}",
+                     shapes.size(), bvh.size())
+    bvh.nearest(
+        points, k, neighbors,
+        [&shapes, &points](const std::size_t point, const std::uint32_t index) {
+            return shape_distance(*shapes[index], points[point]);
+        },
+        max_distance);
+}
+} // namespace geo
@@ -0,0 +1,292 @@
+#include "geo/internal/pch.hpp"
+#include "geo/algorithm/sdf_grid.hpp"
+#include "geo/algorithm/intersection.hpp"
+#include "geo/internal/parallel.hpp"
+#include "geo/profiling/timeline.hpp"
+
+#include <fstream>
+#include <cstring>
+
+namespace geo
+{
+static constexpr std::uint32_t s_tile_samples = sdf_grid::TILE_SIZE * sdf_grid::TILE_SIZE;
+static constexpr std::uint32_t s_magic = 0x46445347; // "GSDF"
+static constexpr std::uint32_t s_version = 1;
+
+sdf_grid::sdf_grid(const std::span<const shape2D *const> shapes, const sdf_settings &settings)
+{
+    bake(shapes, settings);
+}
+
+void sdf_grid::bake(const std::span<const shape2D *const> shapes, const sdf_settings &settings)
+{
+    KIT_PERF_FUNCTION()
+    KIT_ASSERT_ERROR(settings.cell_size > 0.f, "Cell size must be positive: {0}", settings.cell_size)
+    KIT_ASSERT_ERROR(settings.band > 0.f, "Band must be positive: {0}", settings.band)
+
+    m_cell_size = settings.cell_size;
+    m_inv_cell_size = 1.f / settings.cell_size;
+    m_band = settings.band;
+    m_fingerprint = fingerprint(shapes, settings);
+    m_samples.clear();
+    m_width = m_height = m_tiles_x = 0;
+    if (shapes.empty())
+        return;
+
+    aabb2D bounds = shapes[0]->bounding_box();
+    for (std::size_t i = 1; i < shapes.size(); i++)
+        bounds += shapes[i]->bounding_box();
+    bounds.min -= glm::vec2(m_band);
+    bounds.max += glm::vec2(m_band);
+
+    const glm::vec2 extent = bounds.dimension() * m_inv_cell_size;
+    m_tiles_x = ((std::uint32_t)std::ceil(extent.x) + TILE_SIZE) / TILE_SIZE;
+    const std::uint32_t tiles_y = ((std::uint32_t)std::ceil(extent.y) + TILE_SIZE) / TILE_SIZE;
+    m_width = m_tiles_x * TILE_SIZE;
+    m_height = tiles_y * TILE_SIZE;
+    m_bounds = aabb2D(bounds.min, bounds.min + glm::vec2((float)(m_width - 1), (float)(m_height - 1)) * m_cell_size);
+
+    m_samples.resize((std::size_t)m_width * m_height);
+    const std::uint32_t tiles = m_tiles_x * tiles_y;
+
+    // Gradients need the distances of neighbouring tiles, so they are computed once every tile is baked
+    parallel_for(tiles, settings.threads, [this, shapes](const std::uint32_t tile) { bake_tile(tile, shapes); });
+    parallel_for(tiles, settings.threads, [this](const std::uint32_t tile) { compute_gradients(tile); });
+}
+
+void sdf_grid::bake_tile(const std::uint32_t tile, const std::span<const shape2D *const> shapes)
+{
+    const std::uint32_t x0 = (tile % m_tiles_x) * TILE_SIZE;
+    const std::uint32_t y0 = (tile / m_tiles_x) * TILE_SIZE;
+    const aabb2D region{sample_position(x0, y0) - glm::vec2(m_band),
+                        sample_position(x0 + TILE_SIZE - 1, y0 + TILE_SIZE - 1) + glm::vec2(m_band)};
+
+    std::vector<const shape2D *> candidates;
+    for (const shape2D *shape : shapes)
+        if (intersects(region, shape->bounding_box()))
+            candidates.push_back(shape);
+
+    sdf_sample *samples = m_samples.data() + (std::size_t)tile * s_tile_samples;
+    for (std::uint32_t j = 0; j < TILE_SIZE; j++)
+        for (std::uint32_t i = 0; i < TILE_SIZE; i++)
+        {
+            const glm::vec2 p = sample_position(x0 + i, y0 + j);
+            float distance = m_band;
+            // closest_direction_from is finite everywhere, including circle centers and round shape cores
+            for (const shape2D *shape : candidates)
+            {
+                const bool inside = shape->contains_point(p);
+                const float dist = glm::length(shape->closest_direction_from(p));
+                distance = std::min(distance, inside ? -dist : dist);
+            }
+            samples[j * TILE_SIZE + i] = {distance, glm::vec2(0.f)};
+        }
+}
+
+// Central differences, one sided at the borders of the grid
+void sdf_grid::compute_gradients(const std::uint32_t tile)
+{
+    const std::uint32_t x0 = (tile % m_tiles_x) * TILE_SIZE;
+    const std::uint32_t y0 = (tile / m_tiles_x) * TILE_SIZE;
+    for (std::uint32_t y = y0; y < y0 + TILE_SIZE; y++)
+        for (std::uint32_t x = x0; x < x0 + TILE_SIZE; x++)
+        {
+            const std::uint32_t left = x > 0 ? x - 1 : x, right = x < m_width - 1 ? x + 1 : x;
+            const std::uint32_t down = y > 0 ? y - 1 : y, up = y < m_height - 1 ? y + 1 : y;
+            const glm::vec2 gradient{
+                (m_samples[index(right, y)].distance - m_samples[index(left, y)].distance) / (float)(right - left),
+                (m_samples[index(x, up)].distance - m_samples[index(x, down)].distance) / (float)(up - down)};
+
+            const float length2 = glm::length2(gradient);
+            m_samples[index(x, y)].gradient = length2 > 1.e-12f ? gradient / std::sqrt(length2) : glm::vec2(0.f);
+        }
+}
+
+bool sdf_grid::cached_bake(const std::string &path, const std::span<const shape2D *const> shapes,
+                           const sdf_settings &settings)
+{
+    KIT_PERF_FUNCTION()
+    if (load(path, fingerprint(shapes, settings)))
+        return true;
+    bake(shapes, settings);
+    if (!save(path))
+    {
+        KIT_WARN("Failed to save signed distance field cache to {0}", path)
+    }
+    return false;
+}
+
+bool sdf_grid::save(const std::string &path) const
+{
+    std::ofstream file{path, std::ios::binary | std::ios::trunc};
+    if (!file)
+        return false;
+
+    const auto write = [&file](const auto &value) {
+        file.write(reinterpret_cast<const char *>(&value), sizeof(value));
+    };
+    write(s_magic);
+    write(s_version);
+    write(m_fingerprint);
+    write(m_cell_size);
+    write(m_band);
+    write(m_bounds.min);
+    write(m_width);
+    write(m_height);
+    file.write(reinterpret_cast<const char *>(m_samples.data()),
+               (std::streamsize)(m_samples.size() * sizeof(sdf_sample)));
+    return (bool)file;
+}
+
+bool sdf_grid::load(const std::string &path, const std::uint64_t fingerprint)
+{
+    std::ifstream file{path, std::ios::binary};
+    if (!file)
+        return false;
+
+    const auto read = [&file](auto &value) {
+        return (bool)file.read(reinterpret_cast<char *>(&value), sizeof(value));
+    };
+    std::uint32_t magic, version, width, height;
+    std::uint64_t file_fingerprint;
+    float cell_size, band;
+    glm::vec2 min;
+    if (!read(magic) || !read(version) || !read(file_fingerprint) || magic != s_magic || version != s_version ||
+        file_fingerprint != fingerprint)
+        return false;
+    if (!read(cell_size) || !read(band) || !read(min) || !read(width) || !read(height) || width % TILE_SIZE != 0 ||
+        height % TILE_SIZE != 0 || cell_size <= 0.f)
+        return false;
+
+    std::vector<sdf_sample> samples((std::size_t)width * height);
+    if (!file.read(reinterpret_cast<char *>(samples.data()), (std::streamsize)(samples.size() * sizeof(sdf_sample))))
+        return false;
+
+    m_fingerprint = file_fingerprint;
+    m_cell_size = cell_size;
+    m_inv_cell_size = 1.f / cell_size;
+    m_band = band;
+    m_width = width;
+    m_height = height;
+    m_tiles_x = width / TILE_SIZE;
+    m_bounds = aabb2D(min, min + glm::vec2((float)(width - 1), (float)(height - 1)) * cell_size);
+    m_samples = std::move(samples);
+    return true;
+}
+
+// FNV-1a over the raw bytes of every hashed value
+std::uint64_t sdf_grid::fingerprint(const std::span<const shape2D *const> shapes, const sdf_settings &settings)
+{
+    std::uint64_t hash = 14695981039346656037ULL;
+    const auto combine = [&hash](const auto &value) {
+        unsigned char bytes[sizeof(value)];
+        std::memcpy(bytes, &value, sizeof(value));
+        for (const unsigned char byte : bytes)
+            hash = (hash ^ byte) * 1099511628211ULL;
+    };
+    combine(settings.cell_size);
+    combine(settings.band);
+    for (const shape2D *shape : shapes)
+    {
+        combine(shape->bounding_box().min);
+        combine(shape->bounding_box().max);
+        combine(shape->gcentroid());
+        combine(shape->area());
+        combine(shape->inertia());
+    }
+    return hash;
+}
+
+float sdf_grid::distance(const glm::vec2 &p) const
+{
+    return sample(p).distance;
+}
+
+sdf_sample sdf_grid::sample(const glm::vec2 &p) const
+{
+    const glm::vec2 grid = (p - m_bounds.min) * m_inv_cell_size;
+    if (!(grid.x >= 0.f && grid.y >= 0.f && grid.x < (float)(m_width - 1) && grid.y < (float)(m_height - 1)))
+        return {m_band, glm::vec2(0.f)};
+
+    const std::uint32_t x = (std::uint32_t)grid.x, y = (std::uint32_t)grid.y;
+    const float fx = grid.x - (float)x, fy = grid.y - (float)y;
+
+    const sdf_sample &s00 = m_samples[index(x, y)];
+    const sdf_sample &s10 = m_samples[index(x + 1, y)];
+    const sdf_sample &s01 = m_samples[index(x, y + 1)];
+    const sdf_sample &s11 = m_samples[index(x + 1, y + 1)];
+
+    const float w00 = (1.f - fx) * (1.f - fy), w10 = fx * (1.f - fy), w01 = (1.f - fx) * fy, w11 = fx * fy;
+    return {w00 * s00.distance + w10 * s10.distance + w01 * s01.distance + w11 * s11.distance,
+            w00 * s00.gradient + w10 * s10.gradient + w01 * s01.gradient + w11 * s11.gradient};
+}
+
+sdf_contact sdf_grid::contact(const glm::vec2 &position, const float radius) const
+{
+    const sdf_sample smp = sample(position);
+    const float length2 = glm::length2(smp.gradient);
+    return {radius - smp.distance, length2 > 1.e-12f ? smp.gradient / std::sqrt(length2) : glm::vec2(0.f)};
+}
+
+void sdf_grid::contacts(const std::span<const glm::vec2> positions, const float radius,
+                        const std::span<sdf_contact> contacts) const
+{
+    KIT_PERF_FUNCTION()
+    GEO_TIMELINE_FUNCTION(NARROW_PHASE)
+    KIT_ASSERT_ERROR(contacts.size() >= positions.size(), "Not enough room for contacts: {0} positions and {1} slots",
+                     positions.size(), contacts.size())
+    for (std::size_t i = 0; i < positions.size(); i++)
+        contacts[i] = contact(positions[i], radius);
+}
+void sdf_grid::contacts(const std::span<const glm::vec2> positions, const std::span<const float> radii,
+                        const std::span<sdf_contact> contacts) const
+{
+    KIT_PERF_FUNCTION()
+    GEO_TIMELINE_FUNCTION(NARROW_PHASE)
+    KIT_ASSERT_ERROR(radii.size() >= positions.size(), "Not enough radii: {0} positions and {1} radii",
+                     positions.size(), radii.size())
+    KIT_ASSERT_ERROR(contacts.size() >= positions.size(), "Not enough room for contacts: {0} positions and {1} slots",
+                     positions.size(), contacts.size())
+    for (std::size_t i = 0; i < positions.size(); i++)
+        contacts[i] = contact(positions[i], radii[i]);
+}
+
+const aabb2D &sdf_grid::bounds() const
+{
+    return m_bounds;
+}
+float sdf_grid::cell_size() const
+{
+    return m_cell_size;
+}
+float sdf_grid::band() const
+{
+    return m_band;
+}
+std::uint32_t sdf_grid::width() const
+{
+    return m_width;
+}
+std::uint32_t sdf_grid::height() const
+{
+    return m_height;
+}
+std::uint64_t sdf_grid::fingerprint() const
+{
+    return m_fingerprint;
+}
+bool sdf_grid::empty() const
+{
+    return m_samples.empty();
+}
+
+std::size_t sdf_grid::index(const std::uint32_t x, const std::uint32_t y) const
+{
+    const std::size_t tile = (std::size_t)(y / TILE_SIZE) * m_tiles_x + x / TILE_SIZE;
+    return tile * s_tile_samples + (y % TILE_SIZE) * TILE_SIZE + x % TILE_SIZE;
+}
+glm::vec2 sdf_grid::sample_position(const std::uint32_t x, const std::uint32_t y) const
+{
+    return m_bounds.min + glm::vec2((float)x, (float)y) * m_cell_size;
+}
+} // namespace geo
@@ -0,0 +1,332 @@
+#include "geo/internal/pch.hpp"
+#include "geo/algorithm/static_bvh.hpp"
+#include "geo/profiling/timeline.hpp"
+
+#include <future>
+#include <atomic>
+#include <mutex>
+#include <deque>
+#include <thread>
+
+namespace geo
+{
+static constexpr std::uint32_t s_max_sah_depth = 32;
+static constexpr std::uint32_t s_max_bins = 64;
+
+// Half the perimeter, the 2D analogue of the surface area in the SAH cost
+static float half_perimeter(const glm::vec2 &min, const glm::vec2 &max)
+{
+    return (max.x - min.x) + (max.y - min.y);
+}
+
+namespace
+{
+// Subtrees built by other threads live in their own arena, so children are referenced by arena and node index until
+// the whole tree is flattened
+struct build_ref
+{
+    std::uint32_t arena;
+    std::uint32_t index;
+};
+struct build_node
+{
+    glm::vec2 min;
+    glm::vec2 max;
+    build_ref left;
+    build_ref right;
+    std::uint32_t first;
+    std::uint32_t count;
+};
+
+class bvh_builder
+{
+  public:
+    bvh_builder(const std::span<const aabb2D> boxes, const static_bvh_settings &settings)
+        : m_settings(settings), m_primitives(boxes.size())
+    {
+        const std::uint32_t threads =
+            settings.threads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : settings.threads;
+        m_spare_threads = (int)threads - 1;
+        for (std::uint32_t i = 0; i < boxes.size(); i++)
+            m_primitives[i] = {boxes[i].min, boxes[i].max, 0.5f * (boxes[i].min + boxes[i].max), i};
+    }
+
+    build_ref build()
+    {
+        std::vector<build_node> &arena = m_arenas.emplace_back();
+        arena.reserve(2 * m_primitives.size() / std::max(1u, m_settings.max_leaf_size));
+        return {0, build(arena, 0, 0, (std::uint32_t)m_primitives.size(), 0)};
+    }
+
+    void flatten(const build_ref ref, std::vector<static_bvh::node> &nodes) const
+    {
+        const build_node &bn = m_arenas[ref.arena][ref.index];
+        const std::uint32_t index = (std::uint32_t)nodes.size();
+        nodes.push_back({aabb2D(bn.min, bn.max), bn.first, bn.count});
+        if (bn.count != 0)
+            return;
+        flatten(bn.left, nodes);
+        nodes[index].index = (std::uint32_t)nodes.size();
+        flatten(bn.right, nodes);
+    }
+
+    // Input indices in leaf order
+    void leaf_order(std::vector<std::uint32_t> &indices) const
+    {
+        indices.resize(m_primitives.size());
+        for (std::size_t i = 0; i < m_primitives.size(); i++)
+            indices[i] = m_primitives[i].index;
+    }
+
+  private:
+    // Primitives are copied and partitioned in place so that every pass over a range reads contiguous memory
+    struct primitive
+    {
+        glm::vec2 min;
+        glm::vec2 max;
+        glm::vec2 centroid;
+        std::uint32_t index;
+    };
+
+    const static_bvh_settings &m_settings;
+    std::vector<primitive> m_primitives;
+
+    std::deque<std::vector<build_node>> m_arenas;
+    std::mutex m_arena_mutex;
+    std::atomic<int> m_spare_threads;
+
+    struct bin
+    {
+        glm::vec2 min{FLT_MAX};
+        glm::vec2 max{-FLT_MAX};
+        std::uint32_t count = 0;
+    };
+
+    struct split
+    {
+        float cost = FLT_MAX;
+        int axis = -1;
+        std::uint32_t bin = 0;
+        glm::vec2 cmin;
+        float scale;
+    };
+
+    std::uint32_t bin_of(const primitive &prim, const split &sp) const
+    {
+        const float offset = (prim.centroid[sp.axis] - sp.cmin[sp.axis]) * sp.scale;
+        return std::min(m_settings.bins - 1, (std::uint32_t)std::max(0.f, offset));
+    }
+
+    split find_split(const std::uint32_t begin, const std::uint32_t end, const glm::vec2 &cmin,
+                     const glm::vec2 &cmax) const
+    {
+        const std::uint32_t nbins = m_settings.bins;
+        std::array<bin, s_max_bins> bins;
+        std::array<float, s_max_bins> right_costs;
+
+        split best;
+        for (int axis = 0; axis < 2; axis++)
+        {
+            const float extent = cmax[axis] - cmin[axis];
+            if (extent <= 0.f)
+                continue;
+            split candidate{FLT_MAX, axis, 0, cmin, (float)nbins / extent};
+
+            std::fill(bins.begin(), bins.begin() + nbins, bin{});
+            for (std::uint32_t i = begin; i < end; i++)
+            {
+                const primitive &prim = m_primitives[i];
+                bin &b = bins[bin_of(prim, candidate)];
+                b.min = glm::min(b.min, prim.min);
+                b.max = glm::max(b.max, prim.max);
+                b.count++;
+            }
+
+            glm::vec2 min{FLT_MAX}, max{-FLT_MAX};
+            std::uint32_t count = 0;
+            for (std::uint32_t i = nbins - 1; i > 0; i--)
+            {
+                min = glm::min(min, bins[i].min);
+                max = glm::max(max, bins[i].max);
+                count += bins[i].count;
+                right_costs[i] = count > 0 ? (float)count * half_perimeter(min, max) : 0.f;
+            }
+
+            min = glm::vec2(FLT_MAX);
+            max = glm::vec2(-FLT_MAX);
+            count = 0;
+            for (std::uint32_t i = 0; i < nbins - 1; i++)
+            {
+                min = glm::min(min, bins[i].min);
+                max = glm::max(max, bins[i].max);
+                count += bins[i].count;
+                if (count == 0 || count == end - begin)
+                    continue;
+                const float cost = (float)count * half_perimeter(min, max) + right_costs[i + 1];
+                if (cost < best.cost)
+                {
+                    candidate.cost = cost;
+                    candidate.bin = i;
+                    best = candidate;
+                }
+            }
+        }
+        return best;
+    }
+
+    std::uint32_t build(std::vector<build_node> &arena, const std::uint32_t arena_index, const std::uint32_t begin,
+                        const std::uint32_t end, const std::uint32_t depth)
+    {
+        glm::vec2 min{FLT_MAX}, max{-FLT_MAX}, cmin{FLT_MAX}, cmax{-FLT_MAX};
+        for (std::uint32_t i = begin; i < end; i++)
+        {
+            const primitive &prim = m_primitives[i];
+            min = glm::min(min, prim.min);
+            max = glm::max(max, prim.max);
+            cmin = glm::min(cmin, prim.centroid);
+            cmax = glm::max(cmax, prim.centroid);
+        }
+
+        const std::uint32_t index = (std::uint32_t)arena.size();
+        arena.push_back({min, max, {}, {}, begin, end - begin});
+        const std::uint32_t count = end - begin;
+        if (count <= m_settings.max_leaf_size)
+            return index;
+
+        std::uint32_t mid = begin + count / 2;
+        const split sp = depth < s_max_sah_depth ? find_split(begin, end, cmin, cmax) : split{};
+        if (sp.axis != -1)
+        {
+            // A leaf is kept when no split beats testing every primitive, as long as it stays reasonably small
+            if (count <= 4 * m_settings.max_leaf_size && sp.cost >= (float)count * half_perimeter(min, max))
+                return index;
+            mid = (std::uint32_t)(std::partition(m_primitives.begin() + begin, m_primitives.begin() + end,
+                                                 [this, &sp](const primitive &prim) {
+                                                     return bin_of(prim, sp) <= sp.bin;
+                                                 }) -
+                                  m_primitives.begin());
+        }
+        else
+        {
+            const int axis = (cmax.x - cmin.x) >= (cmax.y - cmin.y) ? 0 : 1;
+            std::nth_element(m_primitives.begin() + begin, m_primitives.begin() + mid, m_primitives.begin() + end,
+                             [axis](const primitive &p1, const primitive &p2) {
+                                 return p1.centroid[axis] < p2.centroid[axis];
+                             });
+        }
+
+        build_ref left, right;
+        if (count >= m_settings.parallel_threshold && m_spare_threads.fetch_sub(1) > 0)
+        {
+            std::vector<build_node> *left_arena;
+            std::uint32_t left_arena_index;
+            {
+                std::scoped_lock lock{m_arena_mutex};
+                left_arena_index = (std::uint32_t)m_arenas.size();
+                left_arena = &m_arenas.emplace_back();
+            }
+            std::future<std::uint32_t> left_root = std::async(std::launch::async, [=, this]() {
+                return build(*left_arena, left_arena_index, begin, mid, depth + 1);
+            });
+            right = {arena_index, build(arena, arena_index, mid, end, depth + 1)};
+            left = {left_arena_index, left_root.get()};
+            m_spare_threads.fetch_add(1);
+        }
+        else
+        {
+            if (count >= m_settings.parallel_threshold)
+                m_spare_threads.fetch_add(1);
+            left = {arena_index, build(arena, arena_index, begin, mid, depth + 1)};
+            right = {arena_index, build(arena, arena_index, mid, end, depth + 1)};
+        }
+
+        build_node &bn = arena[index];
+        bn.left = left;
+        bn.right = right;
+        bn.count = 0;
+        return index;
+    }
+};
+} // namespace
+
+static_bvh::static_bvh(const std::span<const aabb2D> boxes, const static_bvh_settings &settings)
+{
+    build(boxes, settings);
+}
+
+void static_bvh::build(const std::span<const aabb2D> boxes, const static_bvh_settings &settings)
+{
+    KIT_PERF_FUNCTION()
+    GEO_TIMELINE_FUNCTION(BROAD_PHASE)
+    KIT_ASSERT_ERROR(settings.max_leaf_size > 0, "Leaves must hold at least one primitive")
+    KIT_ASSERT_ERROR(settings.bins >= 2 && settings.bins <= s_max_bins, "Bin count must be between 2 and {0}: {1}",
+                     s_max_bins, settings.bins)
+    KIT_ASSERT_ERROR(boxes.size() < NONE, "Too many boxes for 32 bit indices: {0}", boxes.size())
+
+    m_nodes.clear();
+    m_boxes.clear();
+    m_indices.clear();
+    if (boxes.empty())
+        return;
+
+    bvh_builder builder{boxes, settings};
+    const build_ref root = builder.build();
+    m_nodes.reserve(2 * boxes.size());
+    builder.flatten(root, m_nodes);
+    m_nodes.shrink_to_fit();
+    builder.leaf_order(m_indices);
+
+    m_boxes.reserve(boxes.size());
+    for (const std::uint32_t index : m_indices)
+        m_boxes.push_back(boxes[index]);
+}
+
+void static_bvh::overlaps(const std::span<const aabb2D> queries,
+                          std::vector<std::pair<std::uint32_t, std::uint32_t>> &pairs) const
+{
+    KIT_PERF_FUNCTION()
+    GEO_TIMELINE_FUNCTION(BROAD_PHASE)
+    for (std::uint32_t i = 0; i < queries.size(); i++)
+        query(queries[i], [&pairs, i](const std::uint32_t index) { pairs.emplace_back(i, index); });
+}
+
+void static_bvh::raycast(const std::span<const ray2D> rays, const std::span<bvh_ray_hit> hits) const
+{
+    KIT_PERF_FUNCTION()
+    GEO_TIMELINE_FUNCTION(BROAD_PHASE)
+    KIT_ASSERT_ERROR(hits.size() >= rays.size(), "Not enough room for hits: {0} rays and {1} slots", rays.size(),
+                     hits.size())
+    for (std::size_t i = 0; i < rays.size(); i++)
+    {
+        bvh_ray_hit &hit = hits[i];
+        hit = {};
+        raycast(rays[i], [&hit](const std::uint32_t index, const float entry) {
+            if (entry < hit.distance)
+                hit = {index, entry};
+            return entry;
+        });
+    }
+}
+
+const std::vector<static_bvh::node> &static_bvh::nodes() const
+{
+    return m_nodes;
+}
+const std::vector<aabb2D> &static_bvh::boxes() const
+{
+    return m_boxes;
+}
+const std::vector<std::uint32_t> &static_bvh::indices() const
+{
+    return m_indices;
+}
+
+std::size_t static_bvh::size() const
+{
+    return m_indices.size();
+}
+bool static_bvh::empty() const
+{
+    return m_indices.empty();
+}
+} // namespace geo
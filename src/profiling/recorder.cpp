@@ -0,0 +1,278 @@
+#include "geo/internal/pch.hpp"
+#include "geo/profiling/recorder.hpp"
+
+#ifdef GEO_ENABLE_RECORDER
+#include "geo/algorithm/intersection.hpp"
+
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace geo::recorder
+{
+static constexpr std::size_t s_flush_size = 64 * 1024;
+
+struct tracked_shape
+{
+    std::uint32_t id;
+    trace::shape_geometry geometry;
+};
+
+static std::atomic<bool> s_recording{false};
+static std::atomic<std::uint32_t> s_session{0};
+static std::atomic<std::uint64_t> s_dropped{0};
+
+static std::mutex s_file_mutex;
+static std::ofstream s_file;
+
+static std::shared_mutex s_shapes_mutex;
+static std::unordered_map<const shape2D *, tracked_shape> s_shapes;
+static std::uint32_t s_next_id = 0;
+
+static void write_to_file(const std::vector<char> &data)
+{
+    std::scoped_lock lock{s_file_mutex};
+    if (s_file.is_open())
+        s_file.write(data.data(), (std::streamsize)data.size());
+}
+
+// Queries of each thread are appended to its own buffer. Its mutex is only contended while the recorder stops. Records
+// left over from a previous session are discarded instead of leaking into the next trace
+struct thread_buffer
+{
+    std::mutex mutex;
+    std::vector<char> data;
+    std::uint32_t session = 0;
+
+    thread_buffer();
+    ~thread_buffer();
+
+    void flush()
+    {
+        if (session == s_session.load(std::memory_order_relaxed))
+            write_to_file(data);
+        data.clear();
+    }
+};
+
+static std::mutex s_buffers_mutex;
+static std::vector<thread_buffer *> s_buffers;
+
+thread_buffer::thread_buffer()
+{
+    data.reserve(s_flush_size + 1024);
+    std::scoped_lock lock{s_buffers_mutex};
+    s_buffers.push_back(this);
+}
+thread_buffer::~thread_buffer()
+{
+    std::scoped_lock lock{s_buffers_mutex};
+    std::erase(s_buffers, this);
+    std::scoped_lock buffer_lock{mutex};
+    flush();
+}
+
+bool start(const std::string &path)
+{
+    KIT_PERF_FUNCTION()
+    stop();
+    std::vector<char> data;
+    trace::write_header(data);
+    {
+        std::shared_lock lock{s_shapes_mutex};
+        for (const auto &[shape, tracked] : s_shapes)
+            trace::write_shape(data, tracked.id, tracked.geometry);
+    }
+
+    std::scoped_lock lock{s_file_mutex};
+    s_file.open(path, std::ios::binary | std::ios::trunc);
+    if (!s_file)
+        return false;
+    s_file.write(data.data(), (std::streamsize)data.size());
+    s_dropped = 0;
+    s_session++;
+    s_recording = true;
+    return true;
+}
+
+void stop()
+{
+    KIT_PERF_FUNCTION()
+    if (!s_recording.exchange(false))
+        return;
+    {
+        std::scoped_lock lock{s_buffers_mutex};
+        for (thread_buffer *buffer : s_buffers)
+        {
+            std::scoped_lock buffer_lock{buffer->mutex};
+            buffer->flush();
+        }
+    }
+    std::scoped_lock lock{s_file_mutex};
+    s_file.close();
+}
+
+bool recording()
+{
+    return s_recording.load(std::memory_order_relaxed);
+}
+
+std::uint64_t dropped()
+{
+    return s_dropped;
+}
+
+std::uint32_t track(const shape2D &shape, const trace::shape_geometry &geometry)
+{
+    std::uint32_t id;
+    {
+        std::scoped_lock lock{s_shapes_mutex};
+        id = s_next_id++;
+        s_shapes[&shape] = {id, geometry};
+    }
+    // Written directly to the file, so that it always precedes the queries using the new id
+    if (recording())
+    {
+        std::vector<char> data;
+        trace::write_shape(data, id, geometry);
+        write_to_file(data);
+    }
+    return id;
+}
+
+void untrack(const shape2D &shape)
+{
+    std::scoped_lock lock{s_shapes_mutex};
+    s_shapes.erase(&shape);
+}
+
+static trace::pose pose_of(const shape2D &shape)
+{
+    trace::pose ps{shape.ltransform()};
+    ps.ltransform.parent = nullptr;
+    if (const kit::transform2D<float> *parent = shape.parent())
+    {
+        ps.has_parent = true;
+        ps.parent = parent->center_scale_rotate_translate3();
+    }
+    return ps;
+}
+
+// Returns false if the query must not be recorded
+static bool begin_query(trace::query &qry, const trace::query_type type, const shape2D &sh1, const shape2D &sh2)
+{
+    if (!recording())
+        return false;
+    {
+        std::shared_lock lock{s_shapes_mutex};
+        const auto it1 = s_shapes.find(&sh1);
+        const auto it2 = s_shapes.find(&sh2);
+        if (it1 == s_shapes.end() || it2 == s_shapes.end())
+        {
+            s_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        qry.shape1 = it1->second.id;
+        qry.shape2 = it2->second.id;
+    }
+    qry.type = type;
+    qry.pose1 = pose_of(sh1);
+    qry.pose2 = pose_of(sh2);
+    return true;
+}
+
+static void end_query(const trace::query &qry)
+{
+    thread_local thread_buffer buffer;
+    std::scoped_lock lock{buffer.mutex};
+    const std::uint32_t session = s_session.load(std::memory_order_relaxed);
+    if (buffer.session != session)
+    {
+        buffer.data.clear();
+        buffer.session = session;
+    }
+    trace::write_query(buffer.data, qry);
+    if (buffer.data.size() >= s_flush_size)
+        buffer.flush();
+}
+
+void record_gjk(const shape2D &sh1, const shape2D &sh2)
+{
+    trace::query qry;
+    if (begin_query(qry, trace::query_type::GJK, sh1, sh2))
+        end_query(qry);
+}
+void record_epa(const shape2D &sh1, const shape2D &sh2, const float threshold)
+{
+    trace::query qry;
+    if (!begin_query(qry, trace::query_type::EPA, sh1, sh2))
+        return;
+    qry.threshold = threshold;
+    end_query(qry);
+}
+void record_epa(const shape2D &sh1, const shape2D &sh2, const std::array<glm::vec2, 3> &simplex,
+                const float threshold)
+{
+    trace::query qry;
+    if (!begin_query(qry, trace::query_type::EPA, sh1, sh2))
+        return;
+    qry.threshold = threshold;
+    qry.from_simplex = true;
+    qry.simplex = simplex;
+    end_query(qry);
+}
+void record_gjk_distance(const shape2D &sh1, const shape2D &sh2, const std::uint32_t max_iterations)
+{
+    trace::query qry;
+    if (!begin_query(qry, trace::query_type::GJK_DISTANCE, sh1, sh2))
+        return;
+    qry.max_iterations = max_iterations;
+    end_query(qry);
+}
+void record_rounded_mtv(const shape2D &sh1, const shape2D &sh2, const float threshold)
+{
+    trace::query qry;
+    if (!begin_query(qry, trace::query_type::ROUNDED_MTV, sh1, sh2))
+        return;
+    qry.threshold = threshold;
+    end_query(qry);
+}
+void record_contact_point(const shape2D &sh1, const shape2D &sh2, const glm::vec2 &mtv)
+{
+    trace::query qry;
+    if (!begin_query(qry, trace::query_type::CONTACT_POINT, sh1, sh2))
+        return;
+    qry.mtv = mtv;
+    end_query(qry);
+}
+void record_sat(const shape2D &sh1, const shape2D &sh2, const sat_cache *cache)
+{
+    trace::query qry;
+    if (!begin_query(qry, trace::query_type::SAT, sh1, sh2))
+        return;
+    if (cache)
+    {
+        qry.has_cache = true;
+        qry.cache_valid = cache->valid;
+        qry.cache_poly1_reference = cache->poly1_reference;
+        qry.cache_normal_index = (std::uint32_t)cache->normal_index;
+    }
+    end_query(qry);
+}
+void record_clipping(const shape2D &sh1, const shape2D &sh2, const sat_result &sat_res,
+                     const bool include_intersections, const std::size_t max_points)
+{
+    trace::query qry;
+    if (!begin_query(qry, trace::query_type::CLIPPING, sh1, sh2))
+        return;
+    qry.poly1_reference = sat_res.poly1_reference;
+    qry.normal_index = (std::uint32_t)sat_res.normal_index;
+    qry.mtv = sat_res.mtv;
+    qry.include_intersections = include_intersections;
+    qry.max_points = (std::uint32_t)max_points;
+    end_query(qry);
+}
+} // namespace geo::recorder
+#endif
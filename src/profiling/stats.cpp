@@ -0,0 +1,299 @@
+#include "geo/internal/pch.hpp"
+#include "geo/profiling/stats.hpp"
+
+#ifdef GEO_ENABLE_STATS
+#include "geo/shapes2D/shape2D.hpp"
+
+#include <memory>
+#include <mutex>
+#include <typeindex>
+#include <unordered_map>
+#if __has_include(<cxxabi.h>)
+#include <cxxabi.h>
+#include <cstdlib>
+#endif
+
+namespace geo::stats
+{
+struct pair_key
+{
+    std::type_index type1;
+    std::type_index type2;
+
+    bool operator==(const pair_key &other) const = default;
+};
+
+struct pair_key_hash
+{
+    std::size_t operator()(const pair_key &key) const
+    {
+        const std::size_t h1 = key.type1.hash_code(), h2 = key.type2.hash_code();
+        return h1 ^ (h2 + 0x9e3779b9 + (h1 << 6) + (h1 >> 2));
+    }
+};
+
+using pair_map = std::unordered_map<pair_key, pair_stats, pair_key_hash>;
+
+// Statistics recorded by a single thread. Its mutex is only contended while snapshot() or reset() merge or clear it, so
+// threads recording at the same time do not serialize each other
+struct thread_stats
+{
+    std::mutex mutex;
+    pair_map stats;
+    bool in_use = false;
+};
+
+static std::mutex s_threads_mutex;
+static std::vector<std::unique_ptr<thread_stats>> s_threads;
+
+static thread_stats *acquire_thread_stats()
+{
+    std::scoped_lock lock{s_threads_mutex};
+    for (const auto &ts : s_threads)
+        if (!ts->in_use)
+        {
+            ts->in_use = true;
+            return ts.get();
+        }
+    thread_stats *ts = s_threads.emplace_back(std::make_unique<thread_stats>()).get();
+    ts->in_use = true;
+    return ts;
+}
+
+// Releases the statistics of the thread when it finishes. They are kept, and reused by the next new thread
+struct thread_stats_handle
+{
+    thread_stats *ts = nullptr;
+    ~thread_stats_handle()
+    {
+        if (!ts)
+            return;
+        std::scoped_lock lock{s_threads_mutex};
+        ts->in_use = false;
+    }
+};
+
+static thread_stats &local_stats()
+{
+    thread_local thread_stats_handle handle;
+    if (!handle.ts)
+        handle.ts = acquire_thread_stats();
+    return *handle.ts;
+}
+
+static std::string type_name(const std::type_index &type)
+{
+#if __has_include(<cxxabi.h>)
+    int status = 0;
+    char *demangled = abi::__cxa_demangle(type.name(), nullptr, nullptr, &status);
+    if (status == 0 && demangled)
+    {
+        std::string name = demangled;
+        std::free(demangled);
+        return name;
+    }
+#endif
+    return type.name();
+}
+
+// The order in which two shapes are queried is irrelevant for the statistics, so both orders share one entry. The
+// mutex of the thread statistics must be locked
+static pair_stats &fetch(thread_stats &ts, const shape2D &sh1, const shape2D &sh2)
+{
+    std::type_index type1 = typeid(sh1), type2 = typeid(sh2);
+    if (type2 < type1)
+        std::swap(type1, type2);
+
+    const auto [it, inserted] = ts.stats.try_emplace({type1, type2});
+    if (inserted)
+    {
+        it->second.shape1 = type_name(type1);
+        it->second.shape2 = type_name(type2);
+    }
+    return it->second;
+}
+
+static void merge(histogram &hist, const histogram &other)
+{
+    for (std::size_t i = 0; i < histogram::BINS; i++)
+        hist.bins[i] += other.bins[i];
+    hist.samples += other.samples;
+    hist.total += other.total;
+    hist.max = std::max(hist.max, other.max);
+}
+
+static void merge(pair_stats &stats, const pair_stats &other)
+{
+    stats.gjk.calls += other.gjk.calls;
+    stats.gjk.intersections += other.gjk.intersections;
+    stats.gjk.support_evaluations += other.gjk.support_evaluations;
+    merge(stats.gjk.iterations, other.gjk.iterations);
+
+    stats.epa.calls += other.epa.calls;
+    stats.epa.valid += other.epa.valid;
+    stats.epa.early_exits += other.epa.early_exits;
+    stats.epa.support_evaluations += other.epa.support_evaluations;
+    merge(stats.epa.iterations, other.epa.iterations);
+    merge(stats.epa.polytope_size, other.epa.polytope_size);
+
+    stats.sat.calls += other.sat.calls;
+    stats.sat.intersections += other.sat.intersections;
+    stats.sat.cache_exits += other.sat.cache_exits;
+    merge(stats.sat.axes_tested, other.sat.axes_tested);
+
+    stats.clipping.calls += other.clipping.calls;
+    stats.clipping.contacts += other.clipping.contacts;
+    merge(stats.clipping.contacts_per_call, other.clipping.contacts_per_call);
+
+    stats.contact_point.calls += other.contact_point.calls;
+    stats.contact_point.support_evaluations += other.contact_point.support_evaluations;
+}
+
+void histogram::add(const std::uint32_t value)
+{
+    bins[std::min<std::size_t>(value, BINS - 1)]++;
+    samples++;
+    total += value;
+    max = std::max(max, value);
+}
+float histogram::mean() const
+{
+    return samples ? (float)total / (float)samples : 0.f;
+}
+
+void record_gjk(const shape2D &sh1, const shape2D &sh2, const std::uint32_t iterations,
+                const std::uint32_t support_evaluations, const bool intersect)
+{
+    thread_stats &ts = local_stats();
+    std::scoped_lock lock{ts.mutex};
+    gjk_stats &stats = fetch(ts, sh1, sh2).gjk;
+    stats.calls++;
+    stats.intersections += intersect;
+    stats.support_evaluations += support_evaluations;
+    stats.iterations.add(iterations);
+}
+void record_epa(const shape2D &sh1, const shape2D &sh2, const std::uint32_t iterations,
+                const std::uint32_t polytope_size, const std::uint32_t support_evaluations, const bool early_exit,
+                const bool valid)
+{
+    thread_stats &ts = local_stats();
+    std::scoped_lock lock{ts.mutex};
+    epa_stats &stats = fetch(ts, sh1, sh2).epa;
+    stats.calls++;
+    stats.valid += valid;
+    stats.early_exits += early_exit;
+    stats.support_evaluations += support_evaluations;
+    stats.iterations.add(iterations);
+    stats.polytope_size.add(polytope_size);
+}
+void record_sat(const shape2D &sh1, const shape2D &sh2, const std::uint32_t axes_tested, const bool cache_exit,
+                const bool intersect)
+{
+    thread_stats &ts = local_stats();
+    std::scoped_lock lock{ts.mutex};
+    sat_stats &stats = fetch(ts, sh1, sh2).sat;
+    stats.calls++;
+    stats.intersections += intersect;
+    stats.cache_exits += cache_exit;
+    stats.axes_tested.add(axes_tested);
+}
+void record_clipping(const shape2D &sh1, const shape2D &sh2, const std::uint32_t contacts)
+{
+    thread_stats &ts = local_stats();
+    std::scoped_lock lock{ts.mutex};
+    clipping_stats &stats = fetch(ts, sh1, sh2).clipping;
+    stats.calls++;
+    stats.contacts += contacts;
+    stats.contacts_per_call.add(contacts);
+}
+void record_contact_point(const shape2D &sh1, const shape2D &sh2, const std::uint32_t support_evaluations)
+{
+    thread_stats &ts = local_stats();
+    std::scoped_lock lock{ts.mutex};
+    contact_point_stats &stats = fetch(ts, sh1, sh2).contact_point;
+    stats.calls++;
+    stats.support_evaluations += support_evaluations;
+}
+
+std::vector<pair_stats> snapshot()
+{
+    pair_map merged;
+    {
+        std::scoped_lock lock{s_threads_mutex};
+        for (const auto &ts : s_threads)
+        {
+            std::scoped_lock tlock{ts->mutex};
+            for (const auto &[key, stats] : ts->stats)
+            {
+                const auto [it, inserted] = merged.try_emplace(key, stats);
+                if (!inserted)
+                    merge(it->second, stats);
+            }
+        }
+    }
+    std::vector<pair_stats> result;
+    result.reserve(merged.size());
+    for (const auto &[key, stats] : merged)
+        result.push_back(stats);
+    return result;
+}
+
+void reset()
+{
+    std::scoped_lock lock{s_threads_mutex};
+    for (const auto &ts : s_threads)
+    {
+        std::scoped_lock tlock{ts->mutex};
+        ts->stats.clear();
+    }
+}
+
+static void write_histogram(std::ostream &stream, const histogram &hist)
+{
+    std::size_t last = hist.bins.size();
+    while (last > 0 && hist.bins[last - 1] == 0)
+        last--;
+
+    stream << "{\"samples\": " << hist.samples << ", \"mean\": " << hist.mean() << ", \"max\": " << hist.max
+           << ", \"bins\": [";
+    for (std::size_t i = 0; i < last; i++)
+        stream << (i == 0 ? "" : ", ") << hist.bins[i];
+    stream << "]}";
+}
+
+void dump_json(std::ostream &stream)
+{
+    const std::vector<pair_stats> pairs = snapshot();
+    stream << "{\n  \"histogram_bins\": " << histogram::BINS << ",\n  \"pairs\": [";
+    for (std::size_t i = 0; i < pairs.size(); i++)
+    {
+        const pair_stats &stats = pairs[i];
+        stream << (i == 0 ? "\n" : ",\n") << "    {\n      \"shapes\": [\"" << stats.shape1 << "\", \"" << stats.shape2
+               << "\"],\n";
+
+        stream << "      \"gjk\": {\"calls\": " << stats.gjk.calls << ", \"intersections\": " << stats.gjk.intersections
+               << ", \"support_evaluations\": " << stats.gjk.support_evaluations << ", \"iterations\": ";
+        write_histogram(stream, stats.gjk.iterations);
+
+        stream << "},\n      \"epa\": {\"calls\": " << stats.epa.calls << ", \"valid\": " << stats.epa.valid
+               << ", \"early_exits\": " << stats.epa.early_exits
+               << ", \"support_evaluations\": " << stats.epa.support_evaluations << ", \"iterations\": ";
+        write_histogram(stream, stats.epa.iterations);
+        stream << ", \"polytope_size\": ";
+        write_histogram(stream, stats.epa.polytope_size);
+
+        stream << "},\n      \"sat\": {\"calls\": " << stats.sat.calls << ", \"intersections\": " << stats.sat.intersections
+               << ", \"cache_exits\": " << stats.sat.cache_exits << ", \"axes_tested\": ";
+        write_histogram(stream, stats.sat.axes_tested);
+
+        stream << "},\n      \"clipping_contacts\": {\"calls\": " << stats.clipping.calls
+               << ", \"contacts\": " << stats.clipping.contacts << ", \"contacts_per_call\": ";
+        write_histogram(stream, stats.clipping.contacts_per_call);
+
+        stream << "},\n      \"mtv_support_contact_point\": {\"calls\": " << stats.contact_point.calls
+               << ", \"support_evaluations\": " << stats.contact_point.support_evaluations << "}\n    }";
+    }
+    stream << "\n  ]\n}\n";
+}
+} // namespace geo::stats
+#endif
@@ -0,0 +1,234 @@
+#include "geo/internal/pch.hpp"
+#include "geo/profiling/timeline.hpp"
+
+#ifdef GEO_ENABLE_TIMELINE
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+
+namespace geo::timeline
+{
+static_assert((RING_CAPACITY & (RING_CAPACITY - 1)) == 0, "Ring capacity must be a power of 2");
+
+// Fields are relaxed atomics so that exporting while a thread writes is not a data race. Torn events are detected by
+// reading the head again after copying them
+struct event
+{
+    std::atomic<const char *> name;
+    std::atomic<std::uint64_t> begin;
+    std::atomic<std::uint64_t> end;
+    std::atomic<category> cat;
+};
+
+// Written by a single thread, and read by the exporting thread
+struct ring
+{
+    std::array<event, RING_CAPACITY> events;
+    std::atomic<std::uint64_t> head{0};
+    std::atomic<std::uint64_t> tail{0};
+    std::uint32_t id = 0;
+    bool in_use = false;
+};
+
+static std::atomic<bool> s_enabled{false};
+
+static std::mutex s_rings_mutex;
+static std::vector<std::unique_ptr<ring>> s_rings;
+
+static ring *acquire_ring()
+{
+    std::scoped_lock lock{s_rings_mutex};
+    for (const auto &rg : s_rings)
+        if (!rg->in_use)
+        {
+            rg->in_use = true;
+            return rg.get();
+        }
+    ring *rg = s_rings.emplace_back(std::make_unique<ring>()).get();
+    rg->id = (std::uint32_t)(s_rings.size() - 1);
+    rg->in_use = true;
+    return rg;
+}
+
+// Releases the ring of the thread when it finishes. Its events are kept until they are overwritten
+struct thread_ring
+{
+    ring *rg = nullptr;
+    ~thread_ring()
+    {
+        if (!rg)
+            return;
+        std::scoped_lock lock{s_rings_mutex};
+        rg->in_use = false;
+    }
+};
+
+const char *category_name(const category cat)
+{
+    switch (cat)
+    {
+    case category::BROAD_PHASE:
+        return "broad_phase";
+    case category::NARROW_PHASE:
+        return "narrow_phase";
+    case category::TRANSFORM:
+        return "transform";
+    case category::SERIALIZATION:
+        return "serialization";
+    }
+    return "unknown";
+}
+
+void enable(const bool enabled)
+{
+    s_enabled.store(enabled, std::memory_order_relaxed);
+}
+bool enabled()
+{
+    return s_enabled.load(std::memory_order_relaxed);
+}
+
+void clear()
+{
+    std::scoped_lock lock{s_rings_mutex};
+    for (const auto &rg : s_rings)
+        rg->tail.store(rg->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+}
+
+std::uint64_t overwritten()
+{
+    std::scoped_lock lock{s_rings_mutex};
+    std::uint64_t count = 0;
+    for (const auto &rg : s_rings)
+    {
+        const std::uint64_t pending =
+            rg->head.load(std::memory_order_acquire) - rg->tail.load(std::memory_order_relaxed);
+        if (pending > RING_CAPACITY)
+            count += pending - RING_CAPACITY;
+    }
+    return count;
+}
+
+std::uint64_t now()
+{
+    return (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+void record(const category cat, const char *name, const std::uint64_t begin, const std::uint64_t end)
+{
+    thread_local thread_ring trg;
+    if (!trg.rg)
+        trg.rg = acquire_ring();
+    ring &rg = *trg.rg;
+
+    const std::uint64_t head = rg.head.load(std::memory_order_relaxed);
+    // Keeps the previous head update ahead of the writes below, which the exporter relies on to detect torn events
+    std::atomic_thread_fence(std::memory_order_release);
+    event &ev = rg.events[head & (RING_CAPACITY - 1)];
+    ev.name.store(name, std::memory_order_relaxed);
+    ev.begin.store(begin, std::memory_order_relaxed);
+    ev.end.store(end, std::memory_order_relaxed);
+    ev.cat.store(cat, std::memory_order_relaxed);
+    rg.head.store(head + 1, std::memory_order_release);
+}
+
+struct exported_event
+{
+    const char *name;
+    std::uint64_t begin;
+    std::uint64_t end;
+    category cat;
+};
+
+static void write_escaped(std::ostream &stream, const char *str)
+{
+    for (; *str; str++)
+    {
+        if (*str == '"' || *str == '\\')
+            stream << '\\';
+        stream << *str;
+    }
+}
+
+void export_chrome_trace(std::ostream &stream)
+{
+    KIT_PERF_FUNCTION()
+    std::vector<std::pair<std::uint32_t, std::vector<exported_event>>> threads;
+    {
+        std::scoped_lock lock{s_rings_mutex};
+        for (const auto &rg : s_rings)
+        {
+            const std::uint64_t head = rg->head.load(std::memory_order_acquire);
+            const std::uint64_t tail = rg->tail.load(std::memory_order_relaxed);
+            const std::uint64_t first = head - tail > RING_CAPACITY ? head - RING_CAPACITY : tail;
+
+            std::vector<exported_event> events;
+            events.reserve(head - first);
+            for (std::uint64_t i = first; i < head; i++)
+            {
+                const event &ev = rg->events[i & (RING_CAPACITY - 1)];
+                events.push_back({ev.name.load(std::memory_order_relaxed), ev.begin.load(std::memory_order_relaxed),
+                                  ev.end.load(std::memory_order_relaxed), ev.cat.load(std::memory_order_relaxed)});
+            }
+
+            // Events the owning thread may have overwritten while they were copied are discarded, including the one it
+            // may be writing at the new head
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const std::uint64_t new_head = rg->head.load(std::memory_order_relaxed);
+            if (new_head + 1 - first > RING_CAPACITY)
+            {
+                const std::uint64_t torn =
+                    std::min<std::uint64_t>(new_head + 1 - first - RING_CAPACITY, events.size());
+                events.erase(events.begin(), events.begin() + (std::ptrdiff_t)torn);
+            }
+            if (!events.empty())
+                threads.emplace_back(rg->id, std::move(events));
+        }
+    }
+
+    std::uint64_t origin = UINT64_MAX;
+    for (const auto &[id, events] : threads)
+        for (const exported_event &ev : events)
+            origin = std::min(origin, ev.begin);
+
+    // Timestamps are written in microseconds, as the format requires
+    const auto micros = [](const std::uint64_t ns) { return (double)ns * 1.e-3; };
+    stream << "{\"traceEvents\":[";
+    bool first = true;
+    const auto separate = [&stream, &first]() {
+        stream << (first ? "\n" : ",\n");
+        first = false;
+    };
+    stream << std::fixed << std::setprecision(3);
+    for (const auto &[id, events] : threads)
+    {
+        separate();
+        stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << id
+               << ",\"args\":{\"name\":\"geo thread " << id << "\"}}";
+        for (const exported_event &ev : events)
+        {
+            separate();
+            stream << "{\"name\":\"";
+            write_escaped(stream, ev.name);
+            stream << "\",\"cat\":\"" << category_name(ev.cat) << "\",\"ph\":\"X\",\"ts\":" << micros(ev.begin - origin)
+                   << ",\"dur\":" << micros(ev.end - ev.begin) << ",\"pid\":0,\"tid\":" << id << '}';
+        }
+    }
+    stream << std::defaultfloat << "\n],\"displayTimeUnit\":\"ns\"}\n";
+}
+
+bool export_chrome_trace(const std::string &path)
+{
+    std::ofstream file{path};
+    if (!file)
+        return false;
+    export_chrome_trace(file);
+    return (bool)file;
+}
+} // namespace geo::timeline
+#endif
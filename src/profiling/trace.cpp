@@ -0,0 +1,252 @@
+#include "geo/internal/pch.hpp"
+#include "geo/profiling/trace.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace geo::trace
+{
+template <class T> static void write(std::vector<char> &buffer, const T &value)
+{
+    const std::size_t size = buffer.size();
+    buffer.resize(size + sizeof(T));
+    std::memcpy(buffer.data() + size, &value, sizeof(T));
+}
+
+static void write_pose(std::vector<char> &buffer, const pose &ps)
+{
+    write(buffer, ps.ltransform.position);
+    write(buffer, ps.ltransform.scale);
+    write(buffer, ps.ltransform.origin);
+    write(buffer, ps.ltransform.rotation);
+    write(buffer, (std::uint8_t)ps.has_parent);
+    // Only the affine part of the parent transform is meaningful
+    if (ps.has_parent)
+        for (int i = 0; i < 3; i++)
+            write(buffer, glm::vec2(ps.parent[i]));
+}
+
+const char *query_name(const query_type type)
+{
+    switch (type)
+    {
+    case query_type::GJK:
+        return "gjk";
+    case query_type::EPA:
+        return "epa";
+    case query_type::GJK_DISTANCE:
+        return "gjk_distance";
+    case query_type::ROUNDED_MTV:
+        return "rounded_mtv";
+    case query_type::CONTACT_POINT:
+        return "contact_point";
+    case query_type::SAT:
+        return "sat";
+    case query_type::CLIPPING:
+        return "clipping";
+    }
+    return "unknown";
+}
+
+void write_header(std::vector<char> &buffer)
+{
+    write(buffer, MAGIC);
+    write(buffer, VERSION);
+}
+
+void write_shape(std::vector<char> &buffer, const std::uint32_t id, const shape_geometry &geometry)
+{
+    write(buffer, record_kind::SHAPE);
+    write(buffer, id);
+    write(buffer, geometry.type);
+    write(buffer, geometry.radius);
+    write(buffer, geometry.length);
+    write(buffer, (std::uint32_t)geometry.vertices.size());
+    for (const glm::vec2 &v : geometry.vertices)
+        write(buffer, v);
+}
+
+void write_query(std::vector<char> &buffer, const query &qry)
+{
+    write(buffer, record_kind::QUERY);
+    write(buffer, qry.type);
+    write(buffer, qry.shape1);
+    write(buffer, qry.shape2);
+    write_pose(buffer, qry.pose1);
+    write_pose(buffer, qry.pose2);
+    switch (qry.type)
+    {
+    case query_type::EPA:
+        write(buffer, qry.threshold);
+        write(buffer, (std::uint8_t)qry.from_simplex);
+        if (qry.from_simplex)
+            write(buffer, qry.simplex);
+        break;
+    case query_type::ROUNDED_MTV:
+        write(buffer, qry.threshold);
+        break;
+    case query_type::GJK_DISTANCE:
+        write(buffer, qry.max_iterations);
+        break;
+    case query_type::CONTACT_POINT:
+        write(buffer, qry.mtv);
+        break;
+    case query_type::SAT:
+        write(buffer, (std::uint8_t)qry.has_cache);
+        if (qry.has_cache)
+        {
+            write(buffer, (std::uint8_t)qry.cache_valid);
+            write(buffer, (std::uint8_t)qry.cache_poly1_reference);
+            write(buffer, qry.cache_normal_index);
+        }
+        break;
+    case query_type::CLIPPING:
+        write(buffer, (std::uint8_t)qry.poly1_reference);
+        write(buffer, qry.normal_index);
+        write(buffer, qry.mtv);
+        write(buffer, (std::uint8_t)qry.include_intersections);
+        write(buffer, qry.max_points);
+        break;
+    case query_type::GJK:
+        break;
+    }
+}
+
+namespace
+{
+class reader
+{
+  public:
+    reader(const std::vector<char> &data) : m_data(data)
+    {
+    }
+
+    template <class T> bool read(T &value)
+    {
+        if (m_offset + sizeof(T) > m_data.size())
+            return false;
+        std::memcpy(&value, m_data.data() + m_offset, sizeof(T));
+        m_offset += sizeof(T);
+        return true;
+    }
+    bool read(bool &value)
+    {
+        std::uint8_t byte;
+        if (!read(byte))
+            return false;
+        value = byte != 0;
+        return true;
+    }
+
+    bool read(pose &ps)
+    {
+        if (!read(ps.ltransform.position) || !read(ps.ltransform.scale) || !read(ps.ltransform.origin) ||
+            !read(ps.ltransform.rotation) || !read(ps.has_parent))
+            return false;
+        ps.parent = glm::mat3(1.f);
+        if (ps.has_parent)
+            for (int i = 0; i < 3; i++)
+            {
+                glm::vec2 column;
+                if (!read(column))
+                    return false;
+                ps.parent[i] = glm::vec3(column, i == 2 ? 1.f : 0.f);
+            }
+        return true;
+    }
+
+    bool read(shape_geometry &geometry)
+    {
+        std::uint32_t size;
+        if (!read(geometry.type) || !read(geometry.radius) || !read(geometry.length) || !read(size) ||
+            m_offset + size * sizeof(glm::vec2) > m_data.size())
+            return false;
+        geometry.vertices.resize(size);
+        for (glm::vec2 &v : geometry.vertices)
+            read(v);
+        return true;
+    }
+
+    bool read(query &qry)
+    {
+        if (!read(qry.type) || !read(qry.shape1) || !read(qry.shape2) || !read(qry.pose1) || !read(qry.pose2))
+            return false;
+        switch (qry.type)
+        {
+        case query_type::EPA:
+            return read(qry.threshold) && read(qry.from_simplex) && (!qry.from_simplex || read(qry.simplex));
+        case query_type::ROUNDED_MTV:
+            return read(qry.threshold);
+        case query_type::GJK_DISTANCE:
+            return read(qry.max_iterations);
+        case query_type::CONTACT_POINT:
+            return read(qry.mtv);
+        case query_type::SAT:
+            return read(qry.has_cache) &&
+                   (!qry.has_cache ||
+                    (read(qry.cache_valid) && read(qry.cache_poly1_reference) && read(qry.cache_normal_index)));
+        case query_type::CLIPPING:
+            return read(qry.poly1_reference) && read(qry.normal_index) && read(qry.mtv) &&
+                   read(qry.include_intersections) && read(qry.max_points);
+        case query_type::GJK:
+            return true;
+        }
+        return false;
+    }
+
+    bool done() const
+    {
+        return m_offset == m_data.size();
+    }
+
+  private:
+    const std::vector<char> &m_data;
+    std::size_t m_offset = 0;
+};
+} // namespace
+
+bool load(const std::string &path, trace &tr)
+{
+    KIT_PERF_FUNCTION()
+    std::ifstream file{path, std::ios::binary};
+    if (!file)
+        return false;
+    const std::vector<char> data{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+
+    reader rd{data};
+    std::uint32_t magic, version;
+    if (!rd.read(magic) || !rd.read(version) || magic != MAGIC || version != VERSION)
+        return false;
+
+    tr.shapes.clear();
+    tr.queries.clear();
+    while (!rd.done())
+    {
+        record_kind kind;
+        if (!rd.read(kind))
+            break;
+        if (kind == record_kind::SHAPE)
+        {
+            std::uint32_t id;
+            shape_geometry geometry;
+            if (!rd.read(id) || !rd.read(geometry))
+                break;
+            tr.shapes[id] = std::move(geometry);
+        }
+        else if (kind == record_kind::QUERY)
+        {
+            query qry;
+            if (!rd.read(qry))
+                break;
+            tr.queries.push_back(qry);
+        }
+        else
+        {
+            KIT_WARN("Unknown trace record kind {0}, the rest of the trace is ignored", (int)kind)
+            break;
+        }
+    }
+    return true;
+}
+} // namespace geo::trace
@@ -0,0 +1,283 @@
+#include "geo/internal/pch.hpp"
+#include "geo/serialization/snapshot.hpp"
+#include "geo/profiling/timeline.hpp"
+
+namespace geo
+{
+void bit_writer::write(const std::uint32_t value, const std::uint32_t bits)
+{
+    KIT_ASSERT_ERROR(bits <= 32, "Cannot write more than 32 bits at once: {0}", bits)
+    for (std::uint32_t written = 0; written < bits;)
+    {
+        const std::uint32_t offset = m_bits % 8;
+        if (offset == 0)
+            m_bytes.push_back(0);
+        const std::uint32_t chunk = std::min(8 - offset, bits - written);
+        const std::uint32_t mask = (1u << chunk) - 1;
+        m_bytes.back() |= (std::uint8_t)(((value >> written) & mask) << offset);
+        written += chunk;
+        m_bits += chunk;
+    }
+}
+void bit_writer::clear()
+{
+    m_bytes.clear();
+    m_bits = 0;
+}
+
+const std::vector<std::uint8_t> &bit_writer::bytes() const
+{
+    return m_bytes;
+}
+std::size_t bit_writer::bit_count() const
+{
+    return m_bits;
+}
+
+bit_reader::bit_reader(const std::span<const std::uint8_t> bytes) : m_bytes(bytes)
+{
+}
+
+bool bit_reader::read(std::uint32_t &value, const std::uint32_t bits)
+{
+    KIT_ASSERT_ERROR(bits <= 32, "Cannot read more than 32 bits at once: {0}", bits)
+    if (m_bit + bits > 8 * m_bytes.size())
+        return false;
+
+    std::uint32_t result = 0;
+    for (std::uint32_t read = 0; read < bits;)
+    {
+        const std::uint32_t offset = m_bit % 8;
+        const std::uint32_t chunk = std::min(8 - offset, bits - read);
+        const std::uint32_t mask = (1u << chunk) - 1;
+        result |= (((std::uint32_t)m_bytes[m_bit / 8] >> offset) & mask) << read;
+        read += chunk;
+        m_bit += chunk;
+    }
+    value = result;
+    return true;
+}
+
+// Ranges of quantized_transform::values that are flagged together: position, rotation, scale and origin
+static constexpr std::array<std::pair<std::size_t, std::size_t>, 4> s_groups{{{0, 2}, {2, 3}, {3, 5}, {5, 7}}};
+
+// Deltas are zigzag encoded and written with a 2 bit prefix selecting one of these widths
+static constexpr std::array<std::uint32_t, 4> s_widths{4, 8, 16, 32};
+
+static void write_delta(bit_writer &writer, const std::int32_t delta)
+{
+    const std::uint32_t zigzag = ((std::uint32_t)delta << 1) ^ (std::uint32_t)(delta >> 31);
+    std::uint32_t width = 0;
+    while (width < s_widths.size() - 1 && zigzag >> s_widths[width])
+        width++;
+    writer.write(width, 2);
+    writer.write(zigzag, s_widths[width]);
+}
+static bool read_delta(bit_reader &reader, std::int32_t &delta)
+{
+    std::uint32_t width, zigzag;
+    if (!reader.read(width, 2) || !reader.read(zigzag, s_widths[width]))
+        return false;
+    delta = (std::int32_t)((zigzag >> 1) ^ (~(zigzag & 1) + 1));
+    return true;
+}
+
+static std::int32_t quantize(const float value, const float precision)
+{
+    return (std::int32_t)std::lround(value / precision);
+}
+static quantized_transform quantize(const kit::transform2D<float> &transform, const snapshot_settings &settings)
+{
+    return {{quantize(transform.position.x, settings.position_precision),
+             quantize(transform.position.y, settings.position_precision),
+             quantize(transform.rotation, settings.rotation_precision),
+             quantize(transform.scale.x, settings.scale_precision),
+             quantize(transform.scale.y, settings.scale_precision),
+             quantize(transform.origin.x, settings.position_precision),
+             quantize(transform.origin.y, settings.position_precision)}};
+}
+
+static void apply(shape2D &shape, const quantized_transform &qt, const snapshot_settings &settings)
+{
+    const auto &v = qt.values;
+    const float pp = settings.position_precision, sp = settings.scale_precision;
+
+    shape.begin_update();
+    shape.lposition(glm::vec2((float)v[0] * pp, (float)v[1] * pp));
+    shape.lrotation((float)v[2] * settings.rotation_precision);
+    shape.lscale(glm::vec2((float)v[3] * sp, (float)v[4] * sp));
+    shape.origin(glm::vec2((float)v[5] * pp, (float)v[6] * pp));
+    shape.end_update();
+}
+
+// Sequence numbers wrap around, so a is newer than b if it is less than half of the range ahead
+static bool newer(const std::uint32_t a, const std::uint32_t b)
+{
+    return (std::int32_t)(a - b) > 0;
+}
+
+snapshot_encoder::snapshot_encoder(const snapshot_settings &settings) : m_settings(settings)
+{
+    KIT_ASSERT_ERROR(settings.history > 0, "The snapshot history must keep at least one snapshot")
+}
+
+const std::vector<std::uint8_t> &snapshot_encoder::encode(const std::span<const shape2D *const> shapes,
+                                                          bool keyframe)
+{
+    KIT_PERF_FUNCTION()
+    GEO_TIMELINE_FUNCTION(SERIALIZATION)
+    keyframe |= m_baseline.sequence == 0 || m_baseline.transforms.size() != shapes.size();
+    if (++m_sequence == 0)
+        m_sequence = 1;
+
+    m_writer.clear();
+    m_writer.write(keyframe, 1);
+    m_writer.write(m_sequence, 32);
+    if (!keyframe)
+        m_writer.write(m_baseline.sequence, 32);
+    m_writer.write((std::uint32_t)shapes.size(), 32);
+
+    snapshot_state state{m_sequence, {}};
+    state.transforms.reserve(shapes.size());
+    for (std::size_t i = 0; i < shapes.size(); i++)
+    {
+        const quantized_transform &current =
+            state.transforms.emplace_back(quantize(shapes[i]->ltransform(), m_settings));
+        const quantized_transform baseline = keyframe ? quantized_transform{} : m_baseline.transforms[i];
+
+        std::uint32_t mask = 0;
+        for (std::size_t g = 0; g < s_groups.size(); g++)
+            for (std::size_t j = s_groups[g].first; j < s_groups[g].second; j++)
+                if (current.values[j] != baseline.values[j])
+                    mask |= 1u << g;
+
+        m_writer.write(mask != 0, 1);
+        if (!mask)
+            continue;
+        m_writer.write(mask, (std::uint32_t)s_groups.size());
+
+        // Unsigned arithmetic wraps instead of overflowing, and the decoder wraps back
+        for (std::size_t g = 0; g < s_groups.size(); g++)
+            if (mask & (1u << g))
+                for (std::size_t j = s_groups[g].first; j < s_groups[g].second; j++)
+                    write_delta(m_writer,
+                                (std::int32_t)((std::uint32_t)current.values[j] - (std::uint32_t)baseline.values[j]));
+    }
+
+    if (!m_acknowledged)
+        m_baseline = std::move(state);
+    else
+    {
+        if (m_unacknowledged.size() == m_settings.history)
+            m_unacknowledged.erase(m_unacknowledged.begin());
+        m_unacknowledged.push_back(std::move(state));
+    }
+    return m_writer.bytes();
+}
+
+void snapshot_encoder::acknowledge(const std::uint32_t sequence)
+{
+    // Until now the baseline was the previous snapshot, which the decoder may not have received
+    if (!m_acknowledged)
+    {
+        m_acknowledged = true;
+        if (m_baseline.sequence != sequence)
+            m_baseline = {};
+        return;
+    }
+
+    const auto it = std::find_if(m_unacknowledged.begin(), m_unacknowledged.end(),
+                                 [sequence](const snapshot_state &state) { return state.sequence == sequence; });
+    if (it == m_unacknowledged.end())
+        return;
+    m_baseline = std::move(*it);
+    m_unacknowledged.erase(m_unacknowledged.begin(), it + 1);
+}
+
+std::uint32_t snapshot_encoder::sequence() const
+{
+    return m_sequence;
+}
+const snapshot_settings &snapshot_encoder::settings() const
+{
+    return m_settings;
+}
+
+snapshot_decoder::snapshot_decoder(const snapshot_settings &settings) : m_settings(settings)
+{
+    KIT_ASSERT_ERROR(settings.history > 0, "The snapshot history must keep at least one snapshot")
+}
+
+bool snapshot_decoder::decode(const std::span<const std::uint8_t> snapshot, const std::span<shape2D *const> shapes)
+{
+    KIT_PERF_FUNCTION()
+    GEO_TIMELINE_FUNCTION(SERIALIZATION)
+    bit_reader reader{snapshot};
+    std::uint32_t keyframe, sequence, baseline_sequence = 0, count;
+    if (!reader.read(keyframe, 1) || !reader.read(sequence, 32) || (!keyframe && !reader.read(baseline_sequence, 32)) ||
+        !reader.read(count, 32) || count != shapes.size())
+        return false;
+    if (!m_states.empty() && !newer(sequence, m_states.back().sequence))
+        return false;
+
+    snapshot_state state{sequence, {}};
+    auto baseline = m_states.end();
+    if (keyframe)
+        state.transforms.assign(count, {});
+    else
+    {
+        baseline = std::find_if(m_states.begin(), m_states.end(), [baseline_sequence](const snapshot_state &st) {
+            return st.sequence == baseline_sequence;
+        });
+        if (baseline == m_states.end() || baseline->transforms.size() != count)
+            return false;
+        state.transforms = baseline->transforms;
+    }
+
+    for (std::size_t i = 0; i < shapes.size(); i++)
+    {
+        std::uint32_t changed, mask;
+        if (!reader.read(changed, 1))
+            return false;
+
+        // Keyframes skip transforms equal to the zero baseline, which must still be applied
+        if (!changed)
+        {
+            if (keyframe)
+                apply(*shapes[i], state.transforms[i], m_settings);
+            continue;
+        }
+        if (!reader.read(mask, (std::uint32_t)s_groups.size()))
+            return false;
+
+        quantized_transform &transform = state.transforms[i];
+        for (std::size_t g = 0; g < s_groups.size(); g++)
+            if (mask & (1u << g))
+                for (std::size_t j = s_groups[g].first; j < s_groups[g].second; j++)
+                {
+                    std::int32_t delta;
+                    if (!read_delta(reader, delta))
+                        return false;
+                    transform.values[j] = (std::int32_t)((std::uint32_t)transform.values[j] + (std::uint32_t)delta);
+                }
+        apply(*shapes[i], transform, m_settings);
+    }
+
+    // The encoder only moves its baseline forward, so older snapshots will not be referenced again
+    if (baseline != m_states.end())
+        m_states.erase(m_states.begin(), baseline);
+    if (m_states.size() == m_settings.history)
+        m_states.erase(m_states.begin());
+    m_states.push_back(std::move(state));
+    return true;
+}
+
+std::uint32_t snapshot_decoder::sequence() const
+{
+    return m_states.empty() ? 0 : m_states.back().sequence;
+}
+const snapshot_settings &snapshot_decoder::settings() const
+{
+    return m_settings;
+}
+} // namespace geo
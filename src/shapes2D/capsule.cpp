@@ -0,0 +1,143 @@
+#include "geo/internal/pch.hpp"
+#include "geo/shapes2D/capsule.hpp"
+#include "geo/serialization/serialization.hpp"
+
+#include "kit/utility/utils.hpp"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846f
+#endif
+
+namespace geo
+{
+capsule::capsule(const float length, const float radius) : m_length(length), m_radius(radius)
+{
+    KIT_ASSERT_WARN(length >= 0.f, "Creating capsule with negative length: {0}", length)
+    KIT_ASSERT_WARN(radius >= 0.f, "Creating capsule with negative radius: {0}", radius)
+    m_convex = true;
+    update_area_and_inertia();
+    update();
+}
+capsule::capsule(const kit::transform2D<float> &ltransform, const float length, const float radius)
+    : shape2D(ltransform), m_length(length), m_radius(radius)
+{
+    KIT_ASSERT_WARN(length >= 0.f, "Creating capsule with negative length: {0}", length)
+    KIT_ASSERT_WARN(radius >= 0.f, "Creating capsule with negative radius: {0}", radius)
+    m_convex = true;
+    update_area_and_inertia();
+    update();
+}
+
+float capsule::length() const
+{
+    return m_length;
+}
+void capsule::length(const float length)
+{
+    KIT_ASSERT_WARN(length >= 0.f, "Setting capsule length to negative value: {0}", length)
+    m_length = length;
+    update_area_and_inertia();
+    update();
+}
+
+float capsule::radius() const
+{
+    return m_radius;
+}
+void capsule::radius(const float radius)
+{
+    KIT_ASSERT_WARN(radius >= 0.f, "Setting capsule radius to negative value: {0}", radius)
+    m_radius = radius;
+    update_area_and_inertia();
+    bound();
+}
+
+const std::array<glm::vec2, 2> &capsule::segment() const
+{
+    return m_segment;
+}
+glm::vec2 capsule::closest_segment_point(const glm::vec2 &p) const
+{
+    const glm::vec2 edge = m_segment[1] - m_segment[0];
+    const float length2 = glm::length2(edge);
+    if (kit::approaches_zero(length2))
+        return m_segment[0];
+    const float interp = std::clamp(glm::dot(p - m_segment[0], edge) / length2, 0.f, 1.f);
+    return m_segment[0] + interp * edge;
+}
+
+glm::vec2 capsule::support_point(const glm::vec2 &direction) const
+{
+    return core_support_point(direction) + glm::normalize(direction) * m_radius;
+}
+glm::vec2 capsule::core_support_point(const glm::vec2 &direction) const
+{
+    return glm::dot(direction, m_segment[1] - m_segment[0]) > 0.f ? m_segment[1] : m_segment[0];
+}
+float capsule::core_radius() const
+{
+    return m_radius;
+}
+
+bool capsule::contains_point(const glm::vec2 &p) const
+{
+    return glm::distance2(p, closest_segment_point(p)) < m_radius * m_radius;
+}
+
+// Rectangle between the cap centers plus two half disks, each displaced from the centroid by half the length and the
+// distance from a half disk to its own center of mass
+void capsule::update_area_and_inertia()
+{
+    const float hlength = 0.5f * m_length;
+    const float r2 = m_radius * m_radius;
+
+    const float rect_area = 2.f * m_length * m_radius;
+    const float rect_inertia = rect_area * (m_length * m_length + 4.f * r2) / 12.f;
+    const float caps_inertia =
+        (float)M_PI * r2 * (0.5f * r2 + hlength * hlength) + 8.f * hlength * r2 * m_radius / 3.f;
+
+    m_area = rect_area + (float)M_PI * r2;
+    m_inertia = (rect_inertia + caps_inertia) / m_area;
+}
+
+void capsule::bound()
+{
+    const glm::vec2 r = glm::vec2(m_radius);
+    m_aabb.min = glm::min(m_segment[0], m_segment[1]) - r;
+    m_aabb.max = glm::max(m_segment[0], m_segment[1]) + r;
+}
+
+glm::vec2 capsule::closest_direction_from(const glm::vec2 &p) const
+{
+    const glm::vec2 dir = closest_segment_point(p) - p;
+    const float dist2 = glm::length2(dir);
+    if (dist2 > 0.f)
+        return dir - dir * (m_radius / std::sqrt(dist2));
+
+    // On the segment, the closest boundary points lie along its normal
+    const glm::vec2 edge = m_segment[1] - m_segment[0];
+    if (kit::approaches_zero(glm::length2(edge)))
+        return glm::vec2(m_radius, 0.f);
+    return glm::normalize(glm::vec2(-edge.y, edge.x)) * m_radius;
+}
+
+void capsule::on_shape_transform_update(const glm::mat3 &ltransform, const glm::mat3 &gtransform)
+{
+    shape2D::on_shape_transform_update(ltransform, gtransform);
+    const float hlength = 0.5f * m_length;
+    m_segment[0] = gtransform * glm::vec3(-hlength, 0.f, 1.f);
+    m_segment[1] = gtransform * glm::vec3(hlength, 0.f, 1.f);
+}
+
+#ifdef KIT_USE_YAML_CPP
+YAML::Node capsule::encode() const
+{
+    return kit::yaml::codec<capsule>::encode(*this);
+}
+bool capsule::decode(const YAML::Node &node)
+{
+    return kit::yaml::codec<capsule>::decode(node, *this);
+}
+#endif
+
+} // namespace geo
@@ -61,7 +61,20 @@ void circle::bound()
 glm::vec2 circle::closest_direction_from(const glm::vec2 &p) const
 {
     const glm::vec2 dir = m_gcentroid - p;
-    return dir - glm::normalize(dir) * m_radius;
+    const float dist2 = glm::length2(dir);
+    // Every boundary point is equally close to the center
+    if (dist2 == 0.f)
+        return glm::vec2(m_radius, 0.f);
+    return dir - dir * (m_radius / std::sqrt(dist2));
+}
+
+glm::vec2 circle::core_support_point(const glm::vec2 &) const
+{
+    return m_gcentroid;
+}
+float circle::core_radius() const
+{
+    return m_radius;
 }
 
 #ifdef KIT_USE_YAML_CPP
@@ -0,0 +1,260 @@
+#include "geo/internal/pch.hpp"
+#include "geo/shapes2D/dynamic_polygon.hpp"
+#include "geo/shapes2D/polygon_geometry.hpp"
+#include "geo/shapes2D/closest_feature.hpp"
+#include "geo/serialization/serialization.hpp"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846f
+#endif
+
+namespace geo
+{
+dynamic_polygon::dynamic_polygon(const std::span<const glm::vec2> verts, std::pmr::memory_resource *resource)
+    : m_resource(resource)
+{
+    allocate(verts.size());
+    std::copy(verts.begin(), verts.end(), &vertices.locals(0));
+    m_ltransform.position = initialize_properties_and_vertices();
+    update();
+}
+dynamic_polygon::dynamic_polygon(const std::initializer_list<glm::vec2> verts, std::pmr::memory_resource *resource)
+    : dynamic_polygon(std::span<const glm::vec2>(verts.begin(), verts.size()), resource)
+{
+}
+
+dynamic_polygon::dynamic_polygon(const kit::transform2D<float> &ltransform, const std::span<const glm::vec2> verts,
+                                 std::pmr::memory_resource *resource)
+    : shape2D(ltransform), m_resource(resource)
+{
+    allocate(verts.size());
+    std::copy(verts.begin(), verts.end(), &vertices.locals(0));
+    initialize_properties_and_vertices();
+    update();
+}
+dynamic_polygon::dynamic_polygon(const kit::transform2D<float> &ltransform,
+                                 const std::initializer_list<glm::vec2> verts, std::pmr::memory_resource *resource)
+    : dynamic_polygon(ltransform, std::span<const glm::vec2>(verts.begin(), verts.size()), resource)
+{
+}
+
+dynamic_polygon::dynamic_polygon(const dynamic_polygon &other) : shape2D(other), m_resource(other.m_resource)
+{
+    copy_vertices(other);
+}
+dynamic_polygon::dynamic_polygon(dynamic_polygon &&other) noexcept
+    : shape2D(std::move(other)), m_resource(other.m_resource)
+{
+    if (!other.m_spill)
+    {
+        copy_vertices(other);
+        return;
+    }
+    m_spill = other.m_spill;
+    vertices = other.vertices;
+    other.m_spill = nullptr;
+    other.allocate(0);
+}
+dynamic_polygon::~dynamic_polygon()
+{
+    release();
+}
+
+dynamic_polygon &dynamic_polygon::operator=(const dynamic_polygon &other)
+{
+    if (this == &other)
+        return *this;
+    shape2D::operator=(other);
+    release();
+    m_resource = other.m_resource;
+    copy_vertices(other);
+    return *this;
+}
+dynamic_polygon &dynamic_polygon::operator=(dynamic_polygon &&other) noexcept
+{
+    if (this == &other)
+        return *this;
+    shape2D::operator=(std::move(other));
+    release();
+    m_resource = other.m_resource;
+    if (!other.m_spill)
+    {
+        copy_vertices(other);
+        return *this;
+    }
+    m_spill = other.m_spill;
+    vertices = other.vertices;
+    other.m_spill = nullptr;
+    other.allocate(0);
+    return *this;
+}
+
+void dynamic_polygon::allocate(const std::size_t size)
+{
+    glm::vec2 *data = m_inline.data();
+    if (size > INLINE_CAPACITY)
+    {
+        m_spill = static_cast<glm::vec2 *>(m_resource->allocate(5 * size * sizeof(glm::vec2), alignof(glm::vec2)));
+        data = m_spill;
+    }
+
+    vertex_view *views[5] = {&vertices.model, &vertices.locals, &vertices.globals, &vertices.edges,
+                             &vertices.normals};
+    for (std::size_t i = 0; i < 5; i++)
+    {
+        views[i]->m_data = data + i * size;
+        views[i]->m_size = size;
+    }
+}
+void dynamic_polygon::release()
+{
+    if (m_spill)
+        m_resource->deallocate(m_spill, 5 * vertices.size() * sizeof(glm::vec2), alignof(glm::vec2));
+    m_spill = nullptr;
+}
+
+void dynamic_polygon::copy_vertices(const dynamic_polygon &other)
+{
+    allocate(other.vertices.size());
+    std::copy(other.vertices.model.begin(), other.vertices.model.begin() + 5 * other.vertices.size(),
+              &vertices.model(0));
+}
+
+bool dynamic_polygon::spilled() const
+{
+    return m_spill;
+}
+std::pmr::memory_resource *dynamic_polygon::resource() const
+{
+    return m_resource;
+}
+
+glm::vec2 dynamic_polygon::support_point(const glm::vec2 &direction) const
+{
+    std::size_t support = 0;
+    float max_dot = glm::dot(direction, vertices.globals[support] - m_gcentroid);
+    for (std::size_t i = 1; i < vertices.size(); i++)
+    {
+        const float dot = glm::dot(direction, vertices.globals[i] - m_gcentroid);
+        if (dot > max_dot)
+        {
+            max_dot = dot;
+            support = i;
+        }
+    }
+    return vertices.globals[support];
+}
+
+bool dynamic_polygon::contains_point(const glm::vec2 &p) const
+{
+    KIT_ASSERT_WARN(m_convex, "Checking if a point is contained in a non convex polygon yields undefined behaviour.")
+    for (std::size_t i = 0; i < vertices.size(); i++)
+    {
+        const glm::vec2 &normal = vertices.normals[i];
+        const glm::vec2 side = p - vertices.globals[i];
+        if (glm::dot(normal, side) > 0.f)
+            return false;
+    }
+    return true;
+}
+
+glm::vec2 dynamic_polygon::closest_direction_from(const glm::vec2 &p) const
+{
+    if (m_convex && vertices.size() >= closest_feature_search_threshold)
+        return closest_feature_from(vertices, p).direction;
+    float min_dist = FLT_MAX;
+    glm::vec2 closest(0.f);
+    for (std::size_t i = 0; i < vertices.size(); i++)
+    {
+        const glm::vec2 towards = towards_segment_from(vertices.globals[i], vertices.globals[i + 1], p);
+        const float dist = glm::length2(towards);
+        if (min_dist > dist)
+        {
+            min_dist = dist;
+            closest = towards;
+        }
+    }
+    return closest;
+}
+
+void dynamic_polygon::bound()
+{
+    m_aabb.min = glm::vec2(FLT_MAX);
+    m_aabb.max = -glm::vec2(FLT_MAX);
+    for (const glm::vec2 &v : vertices.globals)
+    {
+        m_aabb.min = glm::min(m_aabb.min, v);
+        m_aabb.max = glm::max(m_aabb.max, v);
+    }
+}
+
+std::array<glm::vec2, 4> dynamic_polygon::square(const float size)
+{
+    const float hsize = 0.5f * size;
+    return {glm::vec2(-hsize, -hsize), glm::vec2(hsize, -hsize), glm::vec2(hsize, hsize), glm::vec2(-hsize, hsize)};
+}
+std::array<glm::vec2, 4> dynamic_polygon::rect(const float width, const float height)
+{
+    const float hw = 0.5f * width;
+    const float hh = 0.5f * height;
+    return {glm::vec2(-hw, -hh), glm::vec2(hw, -hh), glm::vec2(hw, hh), glm::vec2(-hw, hh)};
+}
+std::vector<glm::vec2> dynamic_polygon::ngon(const float radius, const std::uint32_t edges)
+{
+    KIT_ASSERT_ERROR(edges >= 3, "Cannot make polygon with less than 3 edges - edges: {0}", edges)
+    std::vector<glm::vec2> vertices(edges);
+    const float dangle = 2.f * (float)M_PI / (float)edges;
+    for (std::size_t i = 0; i < edges; i++)
+    {
+        const float rotation = (float)i * dangle;
+        vertices[i] = {radius * sinf(rotation), radius * cosf(rotation)};
+    }
+    return vertices;
+}
+
+void dynamic_polygon::on_shape_transform_update(const glm::mat3 &ltransform, const glm::mat3 &gtransform)
+{
+    shape2D::on_shape_transform_update(ltransform, gtransform);
+    for (std::size_t i = 0; i < vertices.size(); i++)
+        vertices.locals(i) = ltransform * glm::vec3(vertices.model[i], 1.f);
+    if (m_ltransform.parent)
+        for (std::size_t i = 0; i < vertices.size(); i++)
+            vertices.globals(i) = gtransform * glm::vec3(vertices.model[i], 1.f);
+    else
+        for (std::size_t i = 0; i < vertices.size(); i++)
+            vertices.globals(i) = vertices.locals[i];
+
+    for (std::size_t i = 0; i < vertices.size(); i++)
+    {
+        vertices.edges(i) = vertices.globals[i + 1] - vertices.globals[i];
+        vertices.normals(i) = glm::normalize(glm::vec2(vertices.edges[i].y, -vertices.edges[i].x));
+    }
+}
+
+glm::vec2 dynamic_polygon::initialize_properties_and_vertices()
+{
+    KIT_ASSERT_ERROR(vertices.size() >= 3, "Cannot make polygon with less than 3 vertices - vertices: {0}",
+                     vertices.size())
+    sort_polygon_vertices({&vertices.locals(0), vertices.size()});
+    const glm::vec2 current_lcentroid = polygon_center_of_mass(vertices.locals.span());
+
+    for (std::size_t i = 0; i < vertices.size(); i++)
+        vertices.model(i) = vertices.locals[i] - current_lcentroid;
+
+    m_area = polygon_area(vertices.model.span());
+    m_inertia = polygon_inertia(vertices.model.span(), m_area);
+    m_convex = polygon_convexity(vertices.model.span());
+    return current_lcentroid;
+}
+
+#ifdef KIT_USE_YAML_CPP
+YAML::Node dynamic_polygon::encode() const
+{
+    return kit::yaml::codec<dynamic_polygon>::encode(*this);
+}
+bool dynamic_polygon::decode(const YAML::Node &node)
+{
+    return kit::yaml::codec<dynamic_polygon>::decode(node, *this);
+}
+#endif
+} // namespace geo
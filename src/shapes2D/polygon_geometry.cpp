@@ -0,0 +1,142 @@
+#include "geo/internal/pch.hpp"
+#include "geo/shapes2D/polygon_geometry.hpp"
+
+#include "kit/utility/utils.hpp"
+
+namespace geo
+{
+void sort_polygon_vertices(const std::span<glm::vec2> vertices)
+{
+    glm::vec2 center(0.f);
+    for (const glm::vec2 &v : vertices)
+        center += v;
+    center /= (float)vertices.size();
+    const glm::vec2 reference = vertices[0] - center;
+
+    const auto cmp = [&center, &reference](const glm::vec2 &v1, const glm::vec2 &v2) {
+        const glm::vec2 dir1 = v1 - center, dir2 = v2 - center;
+
+        const float det2 = kit::cross2D(reference, dir2);
+        if (kit::approaches_zero(det2) && glm::dot(reference, dir2) >= 0.f)
+            return false;
+        const float det1 = kit::cross2D(reference, dir1);
+        if (kit::approaches_zero(det1) && glm::dot(reference, dir1) >= 0.f)
+            return true;
+
+        if (det1 * det2 >= 0.f)
+            return kit::cross2D(dir1, dir2) > 0.f;
+        return det1 > 0.f;
+    };
+    std::sort(vertices.begin(), vertices.end(), cmp);
+}
+
+glm::vec2 polygon_center_of_mass(const std::span<const glm::vec2> vertices)
+{
+    const glm::vec2 &p1 = vertices[0];
+    glm::vec2 num(0.f), den(0.f);
+    for (std::size_t i = 1; i < vertices.size() - 1; i++)
+    {
+        const glm::vec2 e1 = vertices[i] - p1;
+        const glm::vec2 e2 = vertices[i + 1] - p1;
+
+        const float crs = std::abs(kit::cross2D(e1, e2));
+        num += (e1 + e2) * crs;
+        den += crs;
+    }
+    return p1 + num / (3.f * den);
+}
+
+float polygon_area(const std::span<const glm::vec2> vertices)
+{
+    float area = 0.f;
+    const glm::vec2 &p1 = vertices[0];
+
+    for (std::size_t i = 1; i < vertices.size() - 1; i++)
+    {
+        const glm::vec2 e1 = vertices[i] - p1;
+        const glm::vec2 e2 = vertices[i + 1] - p1;
+        area += std::abs(kit::cross2D(e1, e2));
+    }
+    return area * 0.5f;
+}
+
+// Sum of the polar moments of the triangles fanned from the origin. Edges seen clockwise from the origin subtract
+float polygon_inertia(const std::span<const glm::vec2> vertices, const float area)
+{
+    float inertia = 0.f;
+    const std::size_t size = vertices.size();
+    for (std::size_t i = 0; i < size; i++)
+    {
+        const glm::vec2 &p1 = vertices[i];
+        const glm::vec2 &p2 = vertices[(i + 1) % size];
+        inertia += kit::cross2D(p1, p2) * (glm::dot(p1, p1) + glm::dot(p1, p2) + glm::dot(p2, p2));
+    }
+    return std::abs(inertia) / (12.f * area);
+}
+
+bool polygon_convexity(const std::span<const glm::vec2> vertices)
+{
+    const std::size_t size = vertices.size();
+    for (std::size_t i = 0; i < size; i++)
+        if (kit::cross2D(vertices[(i + 1) % size] - vertices[i],
+                         vertices[(i + 2) % size] - vertices[(i + 1) % size]) < 0.f)
+            return false;
+
+    return true;
+}
+
+// The swept region is the polygon, a rectangle over each edge and a circular sector at each vertex. Moments of every
+// piece are accumulated around the origin and moved to the combined centroid at the end
+rounded_polygon_properties rounded_polygon_mass_properties(const std::span<const glm::vec2> vertices,
+                                                           const float radius)
+{
+    const float poly_area = polygon_area(vertices);
+    const glm::vec2 poly_centroid = polygon_center_of_mass(vertices);
+
+    float area = poly_area;
+    glm::vec2 moment = poly_area * poly_centroid;
+    float polar = poly_area * polygon_inertia(vertices, poly_area);
+
+    const float r2 = radius * radius;
+    const std::size_t size = vertices.size();
+    for (std::size_t i = 0; i < size; i++)
+    {
+        const glm::vec2 &v1 = vertices[i];
+        const glm::vec2 &v2 = vertices[(i + 1) % size];
+        const glm::vec2 edge = v2 - v1;
+        const float length = glm::length(edge);
+        const glm::vec2 normal = glm::vec2(edge.y, -edge.x) / length;
+
+        const float rect_area = length * radius;
+        const glm::vec2 rect_centroid = 0.5f * (v1 + v2 + normal * radius);
+        area += rect_area;
+        moment += rect_area * rect_centroid;
+        polar += rect_area * ((length * length + r2) / 12.f + glm::length2(rect_centroid));
+
+        const glm::vec2 &v3 = vertices[(i + 2) % size];
+        const glm::vec2 next_edge = v3 - v2;
+        const glm::vec2 next_normal = glm::normalize(glm::vec2(next_edge.y, -next_edge.x));
+        const float angle = std::atan2(kit::cross2D(normal, next_normal), glm::dot(normal, next_normal));
+        if (kit::approaches_zero(angle))
+            continue;
+
+        const float sector_area = 0.5f * angle * r2;
+        const float distance = 4.f * radius * std::sin(0.5f * angle) / (3.f * angle);
+        const glm::vec2 sector_centroid = v2 + glm::normalize(normal + next_normal) * distance;
+        area += sector_area;
+        moment += sector_area * sector_centroid;
+        polar += 0.5f * sector_area * r2 - sector_area * distance * distance +
+                 sector_area * glm::length2(sector_centroid);
+    }
+
+    const glm::vec2 centroid = moment / area;
+    return {area, centroid, (polar - area * glm::length2(centroid)) / area};
+}
+
+glm::vec2 towards_segment_from(const glm::vec2 &p1, const glm::vec2 &p2, const glm::vec2 &p)
+{
+    const float interp = std::clamp(glm::dot(p - p1, p2 - p1) / glm::distance2(p1, p2), 0.f, 1.f);
+    const glm::vec2 proj = p1 + interp * (p2 - p1);
+    return proj - p;
+}
+} // namespace geo
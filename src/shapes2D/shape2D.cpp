@@ -1,5 +1,6 @@
 #include "geo/internal/pch.hpp"
 #include "geo/shapes2D/shape2D.hpp"
+#include "geo/shapes2D/transform_hierarchy.hpp"
 
 namespace geo
 {
@@ -81,15 +82,29 @@ void shape2D::update()
 {
     if (m_pushing_update)
         return;
-    const glm::mat3 ltransform = m_ltransform.center_scale_rotate_translate3(true);
     if (m_ltransform.parent)
     {
-        const glm::mat3 gtransform = m_ltransform.parent->center_scale_rotate_translate3() * ltransform;
-        on_shape_transform_update(ltransform, gtransform);
+        const glm::mat3 *parent_gtransform =
+            m_hierarchy.hierarchy ? m_hierarchy.hierarchy->cached_gtransform(m_hierarchy.node, *m_ltransform.parent)
+                                  : nullptr;
+        if (parent_gtransform)
+            update(*parent_gtransform);
+        else
+            update(m_ltransform.parent->center_scale_rotate_translate3());
+        return;
     }
-    else
-        on_shape_transform_update(ltransform, ltransform);
+    const glm::mat3 ltransform = m_ltransform.center_scale_rotate_translate3(true);
+    on_shape_transform_update(ltransform, ltransform);
+    bound();
+}
 
+void shape2D::update(const glm::mat3 &parent_gtransform)
+{
+    KIT_ASSERT_ERROR(m_ltransform.parent, "Cannot update a shape with a parent transform if it has no parent")
+    if (m_pushing_update)
+        return;
+    const glm::mat3 ltransform = m_ltransform.center_scale_rotate_translate3(true);
+    on_shape_transform_update(ltransform, parent_gtransform * ltransform);
     bound();
 }
 
@@ -142,6 +157,15 @@ void shape2D::origin(const glm::vec2 &origin)
     update();
 }
 
+glm::vec2 shape2D::core_support_point(const glm::vec2 &direction) const
+{
+    return support_point(direction);
+}
+float shape2D::core_radius() const
+{
+    return 0.f;
+}
+
 bool shape2D::contains_origin() const
 {
     return contains_point(glm::vec2(0.f));
@@ -166,4 +190,9 @@ void shape2D::end_update()
     m_pushing_update = false;
     update();
 }
+void shape2D::end_update(const glm::mat3 &parent_gtransform)
+{
+    m_pushing_update = false;
+    update(parent_gtransform);
+}
 } // namespace geo
\ No newline at end of file
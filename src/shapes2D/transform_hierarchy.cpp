@@ -0,0 +1,232 @@
+#include "geo/internal/pch.hpp"
+#include "geo/shapes2D/transform_hierarchy.hpp"
+#include "geo/profiling/timeline.hpp"
+
+#include <glm/matrix.hpp>
+
+namespace geo
+{
+transform_hierarchy::~transform_hierarchy()
+{
+    for (node &nd : m_nodes)
+        unlink_shapes(nd);
+}
+
+transform_hierarchy::node_id transform_hierarchy::add(const kit::transform2D<float> &transform, const node_id parent)
+{
+    KIT_ASSERT_ERROR(parent == NONE || contains(parent), "Parent node {0} does not exist", parent)
+    KIT_ASSERT_ERROR((parent == NONE && !transform.parent) ||
+                         (parent != NONE && transform.parent == m_nodes[parent].transform),
+                     "The parent of the transform must match the transform of the parent node")
+
+    node nd;
+    nd.transform = &transform;
+    nd.parent = parent;
+    nd.depth = parent == NONE ? 0 : m_nodes[parent].depth + 1;
+    nd.parent_transform = transform.parent;
+
+    node_id id;
+    if (!m_free.empty())
+    {
+        id = m_free.back();
+        m_free.pop_back();
+        m_nodes[id] = std::move(nd);
+    }
+    else
+    {
+        id = (node_id)m_nodes.size();
+        m_nodes.push_back(std::move(nd));
+    }
+    m_order.push_back(id);
+    m_order_dirty = true;
+    return id;
+}
+
+void transform_hierarchy::remove(const node_id node)
+{
+    KIT_ASSERT_ERROR(contains(node), "Node {0} does not exist", node)
+    std::vector<node_id> stack{node};
+    while (!stack.empty())
+    {
+        const node_id id = stack.back();
+        stack.pop_back();
+        m_nodes[id].alive = false;
+        unlink_shapes(m_nodes[id]);
+        m_free.push_back(id);
+        for (node_id child = 0; child < m_nodes.size(); child++)
+            if (m_nodes[child].alive && m_nodes[child].parent == id)
+                stack.push_back(child);
+    }
+    std::erase_if(m_order, [this](const node_id id) { return !m_nodes[id].alive; });
+}
+
+void transform_hierarchy::attach(shape2D &shape, const node_id node)
+{
+    KIT_ASSERT_ERROR(contains(node), "Node {0} does not exist", node)
+    m_nodes[node].shapes.push_back(&shape);
+    shape.m_hierarchy.hierarchy = this;
+    shape.m_hierarchy.node = node;
+    shape.parent(m_nodes[node].transform);
+}
+void transform_hierarchy::detach(shape2D &shape, const node_id node)
+{
+    KIT_ASSERT_ERROR(contains(node), "Node {0} does not exist", node)
+    std::erase(m_nodes[node].shapes, &shape);
+    if (shape.m_hierarchy.hierarchy == this && shape.m_hierarchy.node == node)
+        shape.m_hierarchy.hierarchy = nullptr;
+}
+
+void transform_hierarchy::unlink_shapes(node &nd)
+{
+    for (shape2D *shape : nd.shapes)
+        shape->m_hierarchy.hierarchy = nullptr;
+    nd.shapes.clear();
+}
+
+void transform_hierarchy::mark_dirty(const node_id node)
+{
+    KIT_ASSERT_ERROR(contains(node), "Node {0} does not exist", node)
+    m_nodes[node].dirty = true;
+}
+
+bool transform_hierarchy::local_changed(const node &nd) const
+{
+    const kit::transform2D<float> &transform = *nd.transform;
+    return transform.position != nd.position || transform.scale != nd.scale || transform.origin != nd.origin ||
+           transform.rotation != nd.rotation || transform.parent != nd.parent_transform;
+}
+
+transform_hierarchy::node_id transform_hierarchy::find(const kit::transform2D<float> *transform) const
+{
+    if (!transform)
+        return NONE;
+    for (node_id id = 0; id < m_nodes.size(); id++)
+        if (m_nodes[id].alive && m_nodes[id].transform == transform)
+            return id;
+    return NONE;
+}
+
+void transform_hierarchy::rebind_reparented()
+{
+    bool reparented = false;
+    for (const node_id id : m_order)
+    {
+        node &nd = m_nodes[id];
+        const kit::transform2D<float> *parent = nd.parent != NONE ? m_nodes[nd.parent].transform : nullptr;
+        if (nd.transform->parent == parent)
+            continue;
+        nd.parent = find(nd.transform->parent);
+        KIT_ASSERT_ERROR(nd.parent != NONE || !nd.transform->parent,
+                         "The new parent of the transform of node {0} is not in the hierarchy", id)
+        reparented = true;
+    }
+    if (!reparented)
+        return;
+
+    for (const node_id id : m_order)
+    {
+        std::uint32_t depth = 0;
+        for (node_id parent = m_nodes[id].parent; parent != NONE; parent = m_nodes[parent].parent)
+            depth++;
+        m_nodes[id].depth = depth;
+    }
+    m_order_dirty = true;
+}
+
+void transform_hierarchy::update()
+{
+    KIT_PERF_FUNCTION()
+    GEO_TIMELINE_FUNCTION(TRANSFORM)
+    rebind_reparented();
+    if (m_order_dirty)
+    {
+        std::stable_sort(m_order.begin(), m_order.end(),
+                         [this](const node_id id1, const node_id id2) { return m_nodes[id1].depth < m_nodes[id2].depth; });
+        m_order_dirty = false;
+    }
+
+    for (const node_id id : m_order)
+    {
+        node &nd = m_nodes[id];
+        const node *parent = nd.parent != NONE ? &m_nodes[nd.parent] : nullptr;
+        if (!nd.dirty && !local_changed(nd) && (!parent || parent->version == nd.parent_version))
+            continue;
+
+        const kit::transform2D<float> &transform = *nd.transform;
+        const glm::mat3 ltransform = transform.center_scale_rotate_translate3(true);
+        if (parent)
+        {
+            nd.gtransform = parent->gtransform * ltransform;
+            nd.parent_version = parent->version;
+        }
+        else
+            nd.gtransform = ltransform;
+
+        nd.position = transform.position;
+        nd.scale = transform.scale;
+        nd.origin = transform.origin;
+        nd.rotation = transform.rotation;
+        nd.parent_transform = transform.parent;
+        nd.version++;
+        nd.dirty = false;
+
+        for (shape2D *shape : nd.shapes)
+            shape->update(nd.gtransform);
+    }
+}
+
+const glm::mat3 &transform_hierarchy::gtransform(const node_id node) const
+{
+    KIT_ASSERT_ERROR(contains(node), "Node {0} does not exist", node)
+    return m_nodes[node].gtransform;
+}
+const glm::mat3 &transform_hierarchy::inverse_gtransform(const node_id node) const
+{
+    KIT_ASSERT_ERROR(contains(node), "Node {0} does not exist", node)
+    const struct node &nd = m_nodes[node];
+    if (nd.inverse_version != nd.version)
+    {
+        nd.inverse_gtransform = glm::inverse(nd.gtransform);
+        nd.inverse_version = nd.version;
+    }
+    return nd.inverse_gtransform;
+}
+std::uint64_t transform_hierarchy::version(const node_id node) const
+{
+    KIT_ASSERT_ERROR(contains(node), "Node {0} does not exist", node)
+    return m_nodes[node].version;
+}
+const glm::mat3 *transform_hierarchy::cached_gtransform(const node_id node,
+                                                         const kit::transform2D<float> &transform) const
+{
+    if (!contains(node) || m_nodes[node].transform != &transform)
+        return nullptr;
+    return &m_nodes[node].gtransform;
+}
+
+void transform_hierarchy::gtranslate(shape2D &shape, const node_id node, const glm::vec2 &dpos) const
+{
+    KIT_ASSERT_ERROR(shape.parent() == m_nodes[node].transform, "The shape is not attached to node {0}", node)
+    shape.begin_update();
+    shape.ltranslate(glm::vec2(inverse_gtransform(node) * glm::vec3(dpos, 0.f)));
+    shape.end_update(m_nodes[node].gtransform);
+}
+
+bool transform_hierarchy::contains(const node_id node) const
+{
+    return node < m_nodes.size() && m_nodes[node].alive;
+}
+std::size_t transform_hierarchy::size() const
+{
+    return m_order.size();
+}
+void transform_hierarchy::clear()
+{
+    for (node &nd : m_nodes)
+        unlink_shapes(nd);
+    m_nodes.clear();
+    m_order.clear();
+    m_free.clear();
+    m_order_dirty = false;
+}
+} // namespace geo
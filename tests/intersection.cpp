@@ -0,0 +1,85 @@
+#include "geo/internal/pch.hpp"
+#include "tests.hpp"
+#include "geo/algorithm/intersection.hpp"
+#include "geo/shapes2D/capsule.hpp"
+#include "geo/shapes2D/circle.hpp"
+#include "geo/shapes2D/rounded_polygon.hpp"
+
+namespace geo::tests
+{
+static bool approx(const float a, const float b)
+{
+    return std::abs(a - b) < 1.e-3f;
+}
+
+static bool approx(const glm::vec2 &a, const glm::vec2 &b)
+{
+    return approx(a.x, b.x) && approx(a.y, b.y);
+}
+
+// The mtv must have the expected depth, point from sh1 towards sh2 and be the difference between the witnesses
+static void check_mtv(const shape2D &sh1, const shape2D &sh2, const epa_result &result, const float depth)
+{
+    GEO_CHECK(result.valid);
+    GEO_CHECK(approx(glm::length(result.mtv), depth));
+    GEO_CHECK(glm::dot(result.mtv, sh2.gcentroid() - sh1.gcentroid()) >= 0.f);
+    GEO_CHECK(approx(result.witness1 - result.witness2, result.mtv));
+}
+
+static void check_rounded_mtv(const shape2D &sh1, const shape2D &sh2, const float depth)
+{
+    check_mtv(sh1, sh2, rounded_mtv(sh1, sh2), depth);
+    check_mtv(sh2, sh1, rounded_mtv(sh2, sh1), depth);
+}
+
+static void collinear_capsules()
+{
+    capsule cap1(2.f, 0.5f), cap2(2.f, 0.5f);
+    cap2.ltranslate({1.5f, 0.f});
+    check_rounded_mtv(cap1, cap2, 1.f);
+    check_mtv(cap1, cap2, mtv(cap1, cap2), 1.f);
+}
+
+static void capsules_end_to_end()
+{
+    capsule cap1(2.f, 0.5f), cap2(2.f, 0.5f);
+    cap2.ltranslate({2.f, 0.f});
+    check_rounded_mtv(cap1, cap2, 1.f);
+    check_mtv(cap1, cap2, mtv(cap1, cap2), 1.f);
+}
+
+static void rounded_boxes_side_by_side()
+{
+    rounded_polygon<4> box1(polygon<4>::rect(2.f, 1.f), 0.2f), box2(polygon<4>::rect(2.f, 1.f), 0.2f);
+    box2.ltranslate({2.f, 0.f});
+    check_rounded_mtv(box1, box2, 0.4f);
+
+    box2.ltranslate({0.f, 0.3f});
+    check_rounded_mtv(box1, box2, 0.4f);
+}
+
+static void circle_on_core_edge()
+{
+    rounded_polygon<4> box(polygon<4>::rect(2.f, 1.f), 0.2f);
+    circle circ(0.3f);
+    circ.ltranslate({1.f, 0.2f});
+    check_rounded_mtv(box, circ, 0.5f);
+}
+
+static void crossing_capsules()
+{
+    capsule cap1(2.f, 0.5f), cap2(2.f, 0.5f);
+    cap2.lrotation(1.5707963f);
+    check_rounded_mtv(cap1, cap2, 2.f);
+    check_mtv(cap1, cap2, mtv(cap1, cap2), 2.f);
+}
+
+void run_intersection()
+{
+    collinear_capsules();
+    capsules_end_to_end();
+    rounded_boxes_side_by_side();
+    circle_on_core_edge();
+    crossing_capsules();
+}
+} // namespace geo::tests
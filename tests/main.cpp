@@ -0,0 +1,38 @@
+#include "geo/internal/pch.hpp"
+#include "tests.hpp"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace geo::tests
+{
+static std::uint32_t s_failures = 0;
+
+void check(const bool condition, const char *expression, const char *file, const int line)
+{
+    if (condition)
+        return;
+    s_failures++;
+    std::cerr << file << ':' << line << ": check failed: " << expression << '\n';
+}
+
+std::uint32_t failures()
+{
+    return s_failures;
+}
+} // namespace geo::tests
+
+int main()
+{
+    geo::tests::run_intersection();
+    geo::tests::run_polygon_descriptor();
+
+    const std::uint32_t failures = geo::tests::failures();
+    if (failures)
+    {
+        std::cerr << failures << " check(s) failed\n";
+        return EXIT_FAILURE;
+    }
+    std::cout << "All checks passed\n";
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,59 @@
+#include "geo/internal/pch.hpp"
+#include "tests.hpp"
+#include "geo/shapes2D/polygon.hpp"
+
+namespace geo::tests
+{
+static constexpr bool approx(const float a, const float b)
+{
+    return a - b < 1.e-4f && b - a < 1.e-4f;
+}
+
+static constexpr bool approx(const glm::vec2 &a, const glm::vec2 &b)
+{
+    return approx(a.x, b.x) && approx(a.y, b.y);
+}
+
+// Inertia is per unit mass: (w^2 + h^2) / 12 for a rectangle
+static constexpr auto s_rect = make_polygon_descriptor(polygon<4>::rect(2.f, 1.f));
+static_assert(approx(s_rect.area, 2.f));
+static_assert(approx(s_rect.centroid, glm::vec2(0.f)));
+static_assert(approx(s_rect.inertia, 5.f / 12.f));
+static_assert(s_rect.convex);
+
+// (a^2 + b^2) / 18 for a right triangle with legs a and b
+static constexpr auto s_triangle =
+    make_polygon_descriptor(kit::dynarray<glm::vec2, 3>{glm::vec2(0.f), glm::vec2(3.f, 0.f), glm::vec2(0.f, 3.f)});
+static_assert(approx(s_triangle.area, 4.5f));
+static_assert(approx(s_triangle.centroid, glm::vec2(1.f)));
+static_assert(approx(s_triangle.inertia, 1.f));
+static_assert(s_triangle.convex);
+
+// 3 sqrt(3) / 2 r^2 and 5 r^2 / 12 for a regular hexagon
+static constexpr auto s_hexagon = make_polygon_descriptor(polygon<6>::ngon(1.f, 6));
+static_assert(approx(s_hexagon.area, 2.598076f));
+static_assert(approx(s_hexagon.centroid, glm::vec2(0.f)));
+static_assert(approx(s_hexagon.inertia, 5.f / 12.f));
+static_assert(s_hexagon.convex);
+
+// Polygons built from a descriptor must match the ones computing their properties at runtime
+template <std::size_t Size>
+static void check_descriptor(const polygon_descriptor<Size> &desc, const kit::dynarray<glm::vec2, Size> &vertices)
+{
+    const polygon<Size> precomputed(desc);
+    const polygon<Size> computed(vertices);
+    GEO_CHECK(approx(precomputed.area(), computed.area()));
+    GEO_CHECK(approx(precomputed.inertia(), computed.inertia()));
+    GEO_CHECK(approx(precomputed.gcentroid(), computed.gcentroid()));
+    GEO_CHECK(precomputed.convex() == computed.convex());
+    for (std::size_t i = 0; i < Size; i++)
+        GEO_CHECK(approx(precomputed.vertices.model[i], computed.vertices.model[i]));
+}
+
+void run_polygon_descriptor()
+{
+    check_descriptor(s_rect, polygon<4>::rect(2.f, 1.f));
+    check_descriptor(s_triangle, {glm::vec2(0.f), glm::vec2(3.f, 0.f), glm::vec2(0.f, 3.f)});
+    check_descriptor(s_hexagon, polygon<6>::ngon(1.f, 6));
+}
+} // namespace geo::tests
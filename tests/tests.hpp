@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstdint>
+
+namespace geo::tests
+{
+void check(bool condition, const char *expression, const char *file, int line);
+std::uint32_t failures();
+
+void run_intersection();
+void run_polygon_descriptor();
+} // namespace geo::tests
+
+#define GEO_CHECK(condition) geo::tests::check(condition, #condition, __FILE__, __LINE__)
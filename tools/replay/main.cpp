@@ -0,0 +1,258 @@
+#include "geo/internal/pch.hpp"
+#include "geo/profiling/trace.hpp"
+#include "geo/algorithm/intersection.hpp"
+#include "geo/shapes2D/rounded_polygon.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+
+// Re-executes every query of a trace written by geo::recorder, timing each one. Shapes are rebuilt from the recorded
+// geometry: polygons become dynamic_polygon, or rounded_polygon when they have a radius
+static constexpr std::size_t s_rounded_capacity = 64;
+// Largest MaxPoints argument of clipping_contacts the tool can replay
+static constexpr std::size_t s_max_clip_points = 16;
+
+struct timing
+{
+    std::size_t index;
+    const geo::trace::query *query;
+    double ns;
+    // Summary of the query output, to spot behaviour changes between builds replaying the same trace
+    float result;
+};
+
+static void print_usage(const char *exe)
+{
+    std::cerr << "Usage: " << exe
+              << " <trace> [--format csv|json] [--output file] [--repetitions n] [--query gjk|epa|gjk_distance|"
+                 "rounded_mtv|contact_point|sat|clipping]\n";
+}
+
+static std::unique_ptr<geo::shape2D> build_shape(const geo::trace::shape_geometry &geometry)
+{
+    switch (geometry.type)
+    {
+    case geo::trace::shape_type::CIRCLE:
+        return std::make_unique<geo::circle>(geometry.radius);
+    case geo::trace::shape_type::CAPSULE:
+        return std::make_unique<geo::capsule>(geometry.length, geometry.radius);
+    case geo::trace::shape_type::POLYGON:
+        if (geometry.vertices.size() < 3)
+            return nullptr;
+        if (geometry.radius == 0.f)
+            return std::make_unique<geo::dynamic_polygon>(std::span<const glm::vec2>(geometry.vertices));
+        if (geometry.vertices.size() > s_rounded_capacity)
+            return nullptr;
+        return std::make_unique<geo::rounded_polygon<s_rounded_capacity>>(
+            kit::dynarray<glm::vec2, s_rounded_capacity>(geometry.vertices.begin(), geometry.vertices.end()),
+            geometry.radius);
+    }
+    return nullptr;
+}
+
+// Shapes recorded with a parent are given a placeholder parent, and then updated with the recorded parent transform
+static void apply_pose(geo::shape2D &shape, const geo::trace::pose &pose)
+{
+    static const kit::transform2D<float> placeholder{};
+    kit::transform2D<float> ltransform = pose.ltransform;
+    ltransform.parent = pose.has_parent ? &placeholder : nullptr;
+    shape.ltransform(ltransform);
+    if (pose.has_parent)
+        shape.update(pose.parent);
+}
+
+// MaxPoints is a template argument, so the recorded value selects one of the instantiations up to s_max_clip_points
+template <std::size_t MaxPoints>
+static std::optional<float> clip(const geo::trace::query &qry, const geo::dynamic_polygon &poly1,
+                                 const geo::dynamic_polygon &poly2)
+{
+    if constexpr (MaxPoints < s_max_clip_points)
+        if (qry.max_points != MaxPoints)
+            return clip<MaxPoints + 1>(qry, poly1, poly2);
+    if (qry.max_points != MaxPoints)
+        return std::nullopt;
+    const geo::sat_result sat_res{true, qry.poly1_reference, qry.normal_index, 0.f, qry.mtv};
+    return (float)geo::clipping_contacts<MaxPoints>(poly1, poly2, sat_res, qry.include_intersections).size;
+}
+
+static std::optional<float> execute(const geo::trace::query &qry, const geo::shape2D &sh1, const geo::shape2D &sh2,
+                                    const geo::gjk_result *gjk_res)
+{
+    using geo::trace::query_type;
+    switch (qry.type)
+    {
+    case query_type::GJK:
+        return geo::gjk(sh1, sh2).intersect ? 1.f : 0.f;
+    case query_type::EPA:
+        if (qry.from_simplex)
+            return glm::length(geo::epa(sh1, sh2, qry.simplex, qry.threshold).mtv);
+        return glm::length(geo::epa(sh1, sh2, *gjk_res, qry.threshold).mtv);
+    case query_type::GJK_DISTANCE:
+        return geo::gjk_distance(sh1, sh2, qry.max_iterations).distance;
+    case query_type::ROUNDED_MTV:
+        return glm::length(geo::rounded_mtv(sh1, sh2, qry.threshold).mtv);
+    case query_type::CONTACT_POINT: {
+        const glm::vec2 point = geo::mtv_support_contact_point(sh1, sh2, qry.mtv);
+        return point.x + point.y;
+    }
+    case query_type::SAT: {
+        const auto *poly1 = dynamic_cast<const geo::dynamic_polygon *>(&sh1);
+        const auto *poly2 = dynamic_cast<const geo::dynamic_polygon *>(&sh2);
+        if (!poly1 || !poly2)
+            return std::nullopt;
+        geo::sat_cache cache{qry.cache_normal_index, qry.cache_poly1_reference, qry.cache_valid};
+        return geo::sat(*poly1, *poly2, qry.has_cache ? &cache : nullptr).separation;
+    }
+    case query_type::CLIPPING: {
+        const auto *poly1 = dynamic_cast<const geo::dynamic_polygon *>(&sh1);
+        const auto *poly2 = dynamic_cast<const geo::dynamic_polygon *>(&sh2);
+        if (!poly1 || !poly2 || qry.normal_index >= (qry.poly1_reference ? poly1 : poly2)->vertices.size())
+            return std::nullopt;
+        return clip<1>(qry, *poly1, *poly2);
+    }
+    }
+    return std::nullopt;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    const char *path = argv[1];
+    const char *format = "csv";
+    const char *output = nullptr;
+    const char *only = nullptr;
+    std::uint32_t repetitions = 5;
+    for (int i = 2; i < argc; i++)
+    {
+        const bool has_value = i + 1 < argc;
+        if (!std::strcmp(argv[i], "--format") && has_value)
+            format = argv[++i];
+        else if (!std::strcmp(argv[i], "--output") && has_value)
+            output = argv[++i];
+        else if (!std::strcmp(argv[i], "--repetitions") && has_value)
+            repetitions = (std::uint32_t)std::max(1, std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--query") && has_value)
+            only = argv[++i];
+        else
+        {
+            print_usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    const bool json = !std::strcmp(format, "json");
+    if (!json && std::strcmp(format, "csv"))
+    {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    geo::trace::trace tr;
+    if (!geo::trace::load(path, tr))
+    {
+        std::cerr << "Could not read trace: " << path << '\n';
+        return EXIT_FAILURE;
+    }
+
+    std::unordered_map<std::uint32_t, std::unique_ptr<geo::shape2D>> shapes;
+    for (const auto &[id, geometry] : tr.shapes)
+        if (auto shape = build_shape(geometry))
+            shapes.emplace(id, std::move(shape));
+
+    std::vector<timing> timings;
+    timings.reserve(tr.queries.size());
+    std::size_t skipped = 0;
+    for (std::size_t i = 0; i < tr.queries.size(); i++)
+    {
+        const geo::trace::query &qry = tr.queries[i];
+        if (only && std::strcmp(only, geo::trace::query_name(qry.type)))
+            continue;
+        const auto it1 = shapes.find(qry.shape1), it2 = shapes.find(qry.shape2);
+        if (it1 == shapes.end() || it2 == shapes.end())
+        {
+            skipped++;
+            continue;
+        }
+        geo::shape2D &sh1 = *it1->second, &sh2 = *it2->second;
+        apply_pose(sh1, qry.pose1);
+        apply_pose(sh2, qry.pose2);
+
+        // EPA recorded from a gjk result needs that result again, which is deterministic but not part of the timing
+        geo::gjk_result gjk_res;
+        if (qry.type == geo::trace::query_type::EPA && !qry.from_simplex)
+        {
+            gjk_res = geo::gjk(sh1, sh2);
+            if (!gjk_res.intersect)
+            {
+                skipped++;
+                continue;
+            }
+        }
+
+        // The fastest repetition is kept, which filters out preemptions and cold caches
+        double best = std::numeric_limits<double>::max();
+        std::optional<float> result;
+        for (std::uint32_t r = 0; r < repetitions; r++)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            result = execute(qry, sh1, sh2, &gjk_res);
+            const auto end = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double, std::nano>(end - start).count());
+        }
+        if (!result)
+        {
+            skipped++;
+            continue;
+        }
+        timings.push_back({i, &qry, best, *result});
+    }
+
+    std::ofstream file;
+    if (output)
+    {
+        file.open(output);
+        if (!file)
+        {
+            std::cerr << "Could not open output file: " << output << '\n';
+            return EXIT_FAILURE;
+        }
+    }
+    std::ostream &stream = output ? file : std::cout;
+    if (json)
+    {
+        stream << "{\n  \"queries\": [";
+        for (std::size_t i = 0; i < timings.size(); i++)
+        {
+            const timing &tm = timings[i];
+            stream << (i == 0 ? "\n" : ",\n") << "    {\"index\": " << tm.index << ", \"query\": \""
+                   << geo::trace::query_name(tm.query->type) << "\", \"shape1\": " << tm.query->shape1
+                   << ", \"shape2\": " << tm.query->shape2 << ", \"ns\": " << std::fixed << std::setprecision(1)
+                   << tm.ns << std::defaultfloat << ", \"result\": " << tm.result << "}";
+        }
+        stream << "\n  ]\n}\n";
+    }
+    else
+    {
+        stream << "index,query,shape1,shape2,ns,result\n";
+        for (const timing &tm : timings)
+            stream << tm.index << ',' << geo::trace::query_name(tm.query->type) << ',' << tm.query->shape1 << ','
+                   << tm.query->shape2 << ',' << std::fixed << std::setprecision(1) << tm.ns << std::defaultfloat
+                   << ',' << tm.result << '\n';
+    }
+
+    double total = 0.0;
+    for (const timing &tm : timings)
+        total += tm.ns;
+    std::cerr << "Replayed " << timings.size() << " queries in " << std::fixed << std::setprecision(3) << total * 1.e-6
+              << " ms, skipped " << skipped << '\n';
+    return EXIT_SUCCESS;
+}